@@ -10,5 +10,7 @@
 #include "G8RTOS_Semaphores.h"
 #include "G8RTOS_Structures.h"
 #include "G8RTOS_CriticalSection.h"
+#include "G8RTOS_Timers.h"
+#include "G8RTOS_Clock.h"
 
 #endif /* G8RTOS_H_ */
@@ -0,0 +1,33 @@
+// G8RTOS_Clock.h
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-26
+// High resolution monotonic clock for G8RTOS
+
+#ifndef G8RTOS_CLOCK_H_
+#define G8RTOS_CLOCK_H_
+
+/************************************Includes***************************************/
+
+#include <stdint.h>
+
+/************************************Includes***************************************/
+
+/*************************************Defines***************************************/
+
+// Free running 64-bit wide timer, counts system clock cycles
+#define CLOCK_TIMER_BASE        WTIMER0_BASE
+#define CLOCK_TIMER_PERIPH      SYSCTL_PERIPH_WTIMER0
+
+/*************************************Defines***************************************/
+
+/********************************Public Functions***********************************/
+
+void G8RTOS_InitClock(void);
+uint64_t G8RTOS_GetTicks(void);
+uint64_t G8RTOS_GetTimeNs(void);
+uint64_t G8RTOS_GetTimeUs(void);
+void G8RTOS_SleepUs(uint32_t duration);
+
+/********************************Public Functions***********************************/
+
+#endif /* G8RTOS_CLOCK_H_ */
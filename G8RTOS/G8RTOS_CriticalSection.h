@@ -16,6 +16,15 @@
 
 /*************************************Defines***************************************/
 
+// Kernel critical sections mask every interrupt at this priority or lower
+// (numerically >=). Priorities 0 .. MAX_SYSCALL_PRIORITY - 1 are zero-latency:
+// they are never delayed by the kernel, but must not call any G8RTOS function.
+#define MAX_SYSCALL_PRIORITY 1
+
+// BASEPRI register value, NVIC only implements the upper 3 priority bits.
+// Must match KERNEL_BASEPRI in G8RTOS_CriticalSection.s / G8RTOS_SchedulerASM.s
+#define KERNEL_BASEPRI (MAX_SYSCALL_PRIORITY << 5)
+
 /*************************************Defines***************************************/
 
 /******************************Data Type Definitions********************************/
@@ -32,9 +41,14 @@ uint32_t IBit_State;
 
 /********************************Public Functions***********************************/
 
+// PRIMASK based, blocks every interrupt
 extern int32_t StartCriticalSection();
 extern void EndCriticalSection(int32_t IBit_State);
 
+// BASEPRI based, only blocks interrupts that may call into the kernel
+extern int32_t StartKernelCriticalSection();
+extern void EndKernelCriticalSection(int32_t BasePri_State);
+
 /********************************Public Functions***********************************/
 
 
@@ -45,6 +45,7 @@ int32_t G8RTOS_InitFIFO(uint32_t FIFO_index);
 int32_t G8RTOS_ReadFIFO(uint32_t FIFO_index);
 int32_t G8RTOS_WriteFIFO(uint32_t FIFO_index, uint32_t data);
 uint8_t G8RTOS_FIFO_Empty(uint32_t FIFO_index);
+semaphore_t* G8RTOS_GetFIFOSemaphore(uint32_t FIFO_index);
 
 /********************************Public Functions***********************************/
 
@@ -19,8 +19,9 @@
 /* Status Register with the Thumb-bit Set */
 #define THUMBBIT 0x01000000
 
-#define MAX_THREADS 5
+#define MAX_THREADS 6
 #define MAX_PTHREADS 2
+#define MAX_IDLE_HOOKS 4
 #define STACKSIZE 1024
 #define OSINT_PRIORITY 7
 
@@ -39,9 +40,14 @@ typedef enum
     CANNOT_KILL_LAST_THREAD = -5,
     IRQn_INVALID = -6,
     HWI_PRIORITY_INVALID = -7,
-    INVALID_ID = -8
+    INVALID_ID = -8,
+    IDLE_HOOK_LIMIT_REACHED = -9
 } sched_ErrCode_t;
 
+// Idle hook typedef
+// Does one bounded slice of background work, returns true while work remains.
+typedef bool (*idleHook_t)(void);
+
 /******************************Data Type Definitions********************************/
 
 /****************************Data Structure Definitions*****************************/
@@ -81,6 +87,9 @@ sched_ErrCode_t G8RTOS_Add_PeriodicEvent(void (*threadToAdd)(void), uint32_t per
                                          uint32_t execution, uint16_t id);
 void G8RTOS_Change_Period(uint16_t id, uint32_t period);
 
+sched_ErrCode_t G8RTOS_AddIdleHook(idleHook_t hook);
+void G8RTOS_RunIdleHooks(void);
+
 /********************************Public Functions***********************************/
 
 #endif /* G8RTOS_SCHEDULER_H_ */
@@ -48,6 +48,9 @@ typedef struct tcb_t
     struct tcb_t *nextTCB;
     struct tcb_t *previousTCB;
     semaphore_t *blocked;
+    semaphore_t **waitSet;
+    uint8_t waitCount;
+    int8_t waitResult;
     uint32_t sleepCount;
     bool asleep;
     uint8_t priority;
@@ -0,0 +1,69 @@
+// G8RTOS_Timers.h
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-26
+// Software timer service for G8RTOS
+
+#ifndef G8RTOS_TIMERS_H_
+#define G8RTOS_TIMERS_H_
+
+/************************************Includes***************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/************************************Includes***************************************/
+
+/*************************************Defines***************************************/
+
+#define MAX_TIMERS 8
+
+/*************************************Defines***************************************/
+
+/******************************Data Type Definitions********************************/
+
+// Timer ID, negative on error
+typedef int32_t timerID_t;
+
+// Timer mode typedef
+typedef enum
+{
+    TIMER_ONE_SHOT = 0,
+    TIMER_AUTO_RELOAD = 1
+} timerMode_t;
+
+/******************************Data Type Definitions********************************/
+
+/****************************Data Structure Definitions*****************************/
+
+/*
+ *  Software Timer Block:
+ *      - Active timers are kept in a singly linked list sorted by expiry, so
+ *        the tick only ever has to look at the head
+ *      - Callbacks run from SysTick_Handler, keep them short and only use
+ *        non-blocking kernel calls (e.g. signalling a semaphore)
+ * */
+typedef struct swtimer_t
+{
+    void (*callback)(void);
+    uint32_t period;
+    uint32_t expiry;
+    timerMode_t mode;
+    bool used;
+    bool active;
+    struct swtimer_t *nextTimer;
+} swtimer_t;
+
+/****************************Data Structure Definitions*****************************/
+
+/********************************Public Functions***********************************/
+
+timerID_t G8RTOS_CreateTimer(void (*callback)(void), uint32_t period, timerMode_t mode);
+int32_t G8RTOS_StartTimer(timerID_t id);
+int32_t G8RTOS_StopTimer(timerID_t id);
+int32_t G8RTOS_ResetTimer(timerID_t id);
+bool G8RTOS_TimerActive(timerID_t id);
+void G8RTOS_ProcessTimers(void);
+
+/********************************Public Functions***********************************/
+
+#endif /* G8RTOS_TIMERS_H_ */
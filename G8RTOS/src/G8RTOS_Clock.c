@@ -0,0 +1,118 @@
+// G8RTOS_Clock.c
+// Date Created: 2023-07-25
+// Date Updated: 2023-07-27
+// Defines for the high resolution clock
+
+#include "../G8RTOS_Clock.h"
+
+/************************************Includes***************************************/
+
+#include <stdbool.h>
+
+#include "../G8RTOS_Scheduler.h"
+
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+
+/************************************Includes***************************************/
+
+/********************************Private Variables**********************************/
+
+// ticks -> ns is ticks * nsNum / nsDen, reduced so the multiply can't overflow
+static uint32_t nsNum = 1;
+static uint32_t nsDen = 1;
+
+/********************************Private Variables**********************************/
+
+/*******************************Private Functions***********************************/
+
+static uint32_t gcd(uint32_t a, uint32_t b)
+{
+    while (b)
+    {
+        uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+
+    return a;
+}
+
+/*******************************Private Functions***********************************/
+
+/********************************Public Functions***********************************/
+
+// G8RTOS_InitClock
+// Starts the wide timer free running at the system clock. Must be called
+// after the system clock is set.
+// Return: void
+void G8RTOS_InitClock(void)
+{
+    uint32_t clockHz = SysCtlClockGet();
+    uint32_t divisor = gcd(1000000000, clockHz);
+
+    nsNum = 1000000000 / divisor;
+    nsDen = clockHz / divisor;
+
+    SysCtlPeripheralEnable(CLOCK_TIMER_PERIPH);
+    while (!SysCtlPeripheralReady(CLOCK_TIMER_PERIPH))
+        ;
+
+    TimerDisable(CLOCK_TIMER_BASE, TIMER_A);
+
+    // full width on a wide timer is a concatenated 64-bit counter
+    TimerConfigure(CLOCK_TIMER_BASE, TIMER_CFG_PERIODIC_UP);
+    TimerLoadSet64(CLOCK_TIMER_BASE, UINT64_MAX);
+
+    TimerEnable(CLOCK_TIMER_BASE, TIMER_A);
+}
+
+// G8RTOS_GetTicks
+// Gets raw system clock cycles since G8RTOS_InitClock. Lock free, the
+// driverlib read retries if the upper word rolls over mid read, so this is
+// safe from any context including ISRs.
+// Return: uint64_t
+uint64_t G8RTOS_GetTicks(void)
+{
+    return TimerValueGet64(CLOCK_TIMER_BASE);
+}
+
+// G8RTOS_GetTimeNs
+// Gets monotonic time in nanoseconds, resolution is one system clock cycle
+// (12.5 ns at 80 MHz). Safe from ISRs.
+// Return: uint64_t
+uint64_t G8RTOS_GetTimeNs(void)
+{
+    uint64_t ticks = G8RTOS_GetTicks();
+
+    return (ticks / nsDen) * nsNum + ((ticks % nsDen) * nsNum) / nsDen;
+}
+
+// G8RTOS_GetTimeUs
+// Gets monotonic time in microseconds. Safe from ISRs.
+// Return: uint64_t
+uint64_t G8RTOS_GetTimeUs(void)
+{
+    return G8RTOS_GetTimeNs() / 1000;
+}
+
+// G8RTOS_SleepUs
+// Sleeps for a number of microseconds. Whole milliseconds are slept through
+// the scheduler so other threads run, the remainder is spun out on the clock.
+// Param uint32_t "duration": microseconds to sleep
+// Return: void
+void G8RTOS_SleepUs(uint32_t duration)
+{
+    uint64_t wake = G8RTOS_GetTimeNs() + (uint64_t) duration * 1000;
+
+    // the tick may be up to 1 ms in, so sleep one ms short and spin the rest
+    if (duration >= 2000)
+        G8RTOS_Sleep(duration / 1000 - 1);
+
+    while (G8RTOS_GetTimeNs() < wake)
+        ;
+}
+
+/********************************Public Functions***********************************/
@@ -5,6 +5,10 @@
 
 	; Functions Defined
 	.def StartCriticalSection, EndCriticalSection
+	.def StartKernelCriticalSection, EndKernelCriticalSection
+
+; BASEPRI value for kernel critical sections (MAX_SYSCALL_PRIORITY << 5)
+KERNEL_BASEPRI	.set	0x20
 
 	.thumb		; Set to thumb mode
 	.align 2	; Align by 2 bytes (thumb mode uses allignment by 2 or 4)
@@ -34,4 +38,30 @@ EndCriticalSection:
 
 	.endasmfunc
 
+; Starts a kernel critical section
+; 	- Saves the state of the current BASEPRI
+; 	- Masks interrupts at or below the kernel priority, BASEPRI_MAX
+; 	  only ever raises the mask so nested sections are safe
+; Returns: The current BASEPRI State
+StartKernelCriticalSection:
+	.asmfunc
+
+	MRS R0, BASEPRI				; Save BASEPRI to R0 (Return Register)
+	MOV R1, #KERNEL_BASEPRI
+	MSR BASEPRI_MAX, R1			; Mask kernel-aware interrupts
+	BX LR						; Return
+
+	.endasmfunc
+
+; Ends a kernel critical section
+; 	- Restores the state of the BASEPRI given an input
+; Param R0: BASEPRI State to update
+EndKernelCriticalSection:
+	.asmfunc
+
+	MSR BASEPRI, R0		; Save R0 (Param) to BASEPRI
+	BX LR				; Return
+
+	.endasmfunc
+
 ; end G8RTOS_CriticalSection.s
@@ -104,3 +104,15 @@ uint8_t G8RTOS_FIFO_Empty(uint32_t FIFO_index)
     else
         return 1;
 }
+
+// G8RTOS_GetFIFOSemaphore
+// Gets the semaphore counting the data in a FIFO, for use with G8RTOS_WaitAny.
+// Param uint32_t "FIFO_index": Index of FIFO block
+// Return: semaphore_t*, 0 if out of bounds
+semaphore_t* G8RTOS_GetFIFOSemaphore(uint32_t FIFO_index)
+{
+    if (FIFO_index >= FIFO_COUNT)
+        return 0;
+
+    return &(FIFOs[FIFO_index].currentSize);
+}
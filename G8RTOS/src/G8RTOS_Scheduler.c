@@ -11,6 +11,8 @@
 #include <inc/tm4c123gh6pm.h>
 
 #include "../G8RTOS_CriticalSection.h"
+#include "../G8RTOS_Timers.h"
+#include "../G8RTOS_Clock.h"
 
 #include "inc/hw_types.h"
 #include "inc/hw_nvic.h"
@@ -45,6 +47,11 @@ static uint32_t NumberOfThreads = 0;
 static ptcb_t pthreadControlBlocks[MAX_PTHREADS];
 static uint32_t NumberOfPThreads = 0;
 
+// Background work run from the idle thread
+static idleHook_t idleHooks[MAX_IDLE_HOOKS];
+static uint32_t NumberOfIdleHooks = 0;
+static uint32_t nextIdleHook = 0;
+
 /********************************Private Variables**********************************/
 
 /*******************************Private Functions***********************************/
@@ -100,8 +107,11 @@ void G8RTOS_Init(void (*idleThread)(void))
     HWREG(NVIC_VTABLE) = newVTORTable;
 
     SystemTime = 0;
+    G8RTOS_InitClock();
+
     NumberOfThreads = 0;
     NumberOfPThreads = 0;
+    NumberOfIdleHooks = 0;
 
     // add idle thread with special un-killable id
     G8RTOS_AddThread(idleThread, 255, "idle", 0);
@@ -120,9 +130,9 @@ int32_t G8RTOS_Launch()
     // Set currently running thread to the first control block
     CurrentlyRunningThread = &threadControlBlocks[0];
 
-    // lower value means higher priority
-    IntPrioritySet(FAULT_PENDSV, 7);
-    IntPrioritySet(FAULT_SYSTICK, 6);
+    // lower value means higher priority, only the upper 3 bits are implemented
+    IntPrioritySet(FAULT_PENDSV, OSINT_PRIORITY << 5);
+    IntPrioritySet(FAULT_SYSTICK, (OSINT_PRIORITY - 1) << 5);
 
     G8RTOS_Scheduler();
 
@@ -184,36 +194,37 @@ bool isValidThread(tcb_t *thread)
 sched_ErrCode_t G8RTOS_AddAperiodicEvent(void (*threadToAdd)(void), uint8_t threadPriority,
                                          int32_t IRQn)
 {
-    int32_t IBit_State = StartCriticalSection();
+    int32_t BasePri_State = StartKernelCriticalSection();
 
     if (IRQn < 16 || IRQn > 154)
     {
-        EndCriticalSection(IBit_State);
+        EndKernelCriticalSection(BasePri_State);
         return IRQn_INVALID;
     }
 
-    if (threadPriority >= 6)
+    // events may use kernel calls, so they can't sit above the kernel mask
+    if (threadPriority >= OSINT_PRIORITY - 1 || threadPriority < MAX_SYSCALL_PRIORITY)
     {
-        EndCriticalSection(IBit_State);
+        EndKernelCriticalSection(BasePri_State);
         return HWI_PRIORITY_INVALID;
     }
 
     IntRegister(IRQn, threadToAdd);
-    IntPrioritySet(IRQn, (uint32_t) threadPriority);
+    IntPrioritySet(IRQn, threadPriority << 5);
     IntEnable(IRQn);
 
-    EndCriticalSection(IBit_State);
+    EndKernelCriticalSection(BasePri_State);
     return NO_ERROR;
 }
 
 sched_ErrCode_t G8RTOS_Add_PeriodicEvent(void (*threadToAdd)(void), uint32_t period,
                                          uint32_t execution, uint16_t id)
 {
-    int32_t IBit_State = StartCriticalSection();
+    int32_t BasePri_State = StartKernelCriticalSection();
 
     if (NumberOfPThreads >= MAX_PTHREADS)
     {
-        EndCriticalSection(IBit_State);
+        EndKernelCriticalSection(BasePri_State);
         return THREAD_LIMIT_REACHED;
     }
 
@@ -241,14 +252,14 @@ sched_ErrCode_t G8RTOS_Add_PeriodicEvent(void (*threadToAdd)(void), uint32_t per
 
     NumberOfPThreads++;
 
-    EndCriticalSection(IBit_State);
+    EndKernelCriticalSection(BasePri_State);
     return NO_ERROR;
 }
 
 void G8RTOS_Change_Period(uint16_t id, uint32_t period)
 {
 
-    int32_t IBit_State = StartCriticalSection();
+    int32_t BasePri_State = StartKernelCriticalSection();
 
     // find thread
     ptcb_t *to_change;
@@ -263,8 +274,51 @@ void G8RTOS_Change_Period(uint16_t id, uint32_t period)
 
     }
 
-    EndCriticalSection(IBit_State);
+    EndKernelCriticalSection(BasePri_State);
+
+}
+
+// G8RTOS_AddIdleHook
+// Registers a job to be run in slices whenever only the idle thread is ready.
+// Hooks must keep each call short, as a slice can't be preempted by a
+// thread until it returns.
+// Param idleHook_t "hook": slice function, returns true while work remains
+// Return: scheduler error code
+sched_ErrCode_t G8RTOS_AddIdleHook(idleHook_t hook)
+{
+    int32_t BasePri_State = StartKernelCriticalSection();
+
+    if (NumberOfIdleHooks >= MAX_IDLE_HOOKS)
+    {
+        EndKernelCriticalSection(BasePri_State);
+        return IDLE_HOOK_LIMIT_REACHED;
+    }
+
+    idleHooks[NumberOfIdleHooks++] = hook;
 
+    EndKernelCriticalSection(BasePri_State);
+    return NO_ERROR;
+}
+
+// G8RTOS_RunIdleHooks
+// Runs one slice of each idle hook, round-robin. Meant to be looped by the
+// idle thread. After a slice that did work the scheduler is run, so any
+// thread made ready in the meantime takes over straight away.
+// Return: void
+void G8RTOS_RunIdleHooks(void)
+{
+    for (uint32_t i = 0; i < NumberOfIdleHooks; i++)
+    {
+        idleHook_t hook = idleHooks[nextIdleHook];
+
+        nextIdleHook++;
+        if (nextIdleHook >= NumberOfIdleHooks)
+            nextIdleHook = 0;
+
+        // only reschedule after real work, an empty registry just spins
+        if (hook())
+            G8RTOS_Yield();
+    }
 }
 
 // G8RTOS_AddThread
@@ -280,11 +334,14 @@ void G8RTOS_Change_Period(uint16_t id, uint32_t period)
 sched_ErrCode_t G8RTOS_AddThread(void (*threadToAdd)(void), uint8_t threadPriority,
                                  char name[MAX_NAME_LENGTH], uint16_t threadID)
 {
-    int32_t IBit_State = StartCriticalSection();
+    int32_t BasePri_State = StartKernelCriticalSection();
 
     // Check if we can add more threads
     if (NumberOfThreads == MAX_THREADS)
+    {
+        EndKernelCriticalSection(BasePri_State);
         return THREAD_LIMIT_REACHED;
+    }
 
     uint16_t indexToAdd = NumberOfThreads;
 
@@ -299,7 +356,10 @@ sched_ErrCode_t G8RTOS_AddThread(void (*threadToAdd)(void), uint8_t threadPriori
     }
 
     if (threadID == 65535)
+    {
+        EndKernelCriticalSection(BasePri_State);
         return INVALID_ID;
+    }
 
     // Initialize the TCB for the new thread
     tcb_t *newThread = &threadControlBlocks[indexToAdd];
@@ -331,7 +391,7 @@ sched_ErrCode_t G8RTOS_AddThread(void (*threadToAdd)(void), uint8_t threadPriori
 
     NumberOfThreads++;
 
-    EndCriticalSection(IBit_State);
+    EndKernelCriticalSection(BasePri_State);
 
     return NO_ERROR;
 }
@@ -339,11 +399,14 @@ sched_ErrCode_t G8RTOS_AddThread(void (*threadToAdd)(void), uint8_t threadPriori
 void G8RTOS_KillThread(uint16_t threadID)
 {
 
-    int32_t IBit_State = StartCriticalSection();
+    int32_t BasePri_State = StartKernelCriticalSection();
 
     // no killing the idle thread >:(
     if (threadID == 65535)
+    {
+        EndKernelCriticalSection(BasePri_State);
         return;
+    }
 
     // find thread to kill
     tcb_t *to_kill = CurrentlyRunningThread;
@@ -351,7 +414,7 @@ void G8RTOS_KillThread(uint16_t threadID)
     {
         if (to_kill == CurrentlyRunningThread->previousTCB)
         {
-            EndCriticalSection(IBit_State);
+            EndKernelCriticalSection(BasePri_State);
             return; // no thread with given ID exists
         }
 
@@ -362,7 +425,7 @@ void G8RTOS_KillThread(uint16_t threadID)
     to_kill->previousTCB->nextTCB = to_kill->nextTCB;
     to_kill->nextTCB->previousTCB = to_kill->previousTCB;
 
-    EndCriticalSection(IBit_State);
+    EndKernelCriticalSection(BasePri_State);
 
     if (CurrentlyRunningThread->id == threadID)
         G8RTOS_Yield();
@@ -413,6 +476,8 @@ void SysTick_Handler()
         pt = pt->nextPTCB;
     }
 
+    G8RTOS_ProcessTimers();
+
     G8RTOS_Yield();
 }
 
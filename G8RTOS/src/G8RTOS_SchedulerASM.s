@@ -10,6 +10,9 @@
 	; Dependencies
 	.ref CurrentlyRunningThread, G8RTOS_Scheduler
 
+; BASEPRI value for kernel critical sections (MAX_SYSCALL_PRIORITY << 5)
+KERNEL_BASEPRI	.set	0x20
+
 	.thumb		; Set to thumb mode
 	.align 2	; Align by 2 bytes (thumb mode uses allignment by 2 or 4)
 	.text		; Text section
@@ -53,7 +56,9 @@ PendSV_Handler:
 
 	.asmfunc
 
-  CPSID I
+  ; mask kernel-aware interrupts only, zero-latency interrupts stay live
+  MOV R0, #KERNEL_BASEPRI
+  MSR BASEPRI, R0
   PUSH {R4 - R11}
 
   ; start non-provided pendsv code
@@ -90,7 +95,8 @@ PendSV_Handler:
   ; end non-provided pendsv code
 
   POP {R4 - R11}
-  CPSIE I
+  MOV R0, #0
+  MSR BASEPRI, R0
   BX LR
 
 	.endasmfunc
@@ -29,6 +29,13 @@ uint32_t IBit_State;
 
 /********************************Public Variables***********************************/
 
+/*******************************Private Variables***********************************/
+
+// threads blocked in G8RTOS_WaitAny point their blocked field here
+static semaphore_t waitAnyBlocked;
+
+/*******************************Private Variables***********************************/
+
 /********************************Public Functions***********************************/
 
 // G8RTOS_InitSemaphore
@@ -38,9 +45,9 @@ uint32_t IBit_State;
 // Return: void
 void G8RTOS_InitSemaphore(semaphore_t *s, int32_t value)
 {
-    int32_t IBit_State = StartCriticalSection(); // Start critical section
+    int32_t BasePri_State = StartKernelCriticalSection(); // Start critical section
     *s = value;
-    EndCriticalSection(IBit_State); // End critical section
+    EndKernelCriticalSection(BasePri_State); // End critical section
 }
 
 // G8RTOS_WaitSemaphore
@@ -51,20 +58,20 @@ void G8RTOS_InitSemaphore(semaphore_t *s, int32_t value)
 // Return: void
 void G8RTOS_WaitSemaphore(semaphore_t *s)
 {
-    int32_t IBit_State = StartCriticalSection();
+    int32_t BasePri_State = StartKernelCriticalSection();
     (*s)--;
 
     if ((*s) < 0)
     {
         CurrentlyRunningThread->blocked = s;
 
-        EndCriticalSection(IBit_State);
+        EndKernelCriticalSection(BasePri_State);
 
         G8RTOS_Yield();
     }
     else
     {
-        EndCriticalSection(IBit_State);
+        EndKernelCriticalSection(BasePri_State);
     }
 }
 
@@ -75,7 +82,7 @@ void G8RTOS_WaitSemaphore(semaphore_t *s)
 // Return: void
 void G8RTOS_SignalSemaphore(semaphore_t *s)
 {
-    int32_t IBit_State = StartCriticalSection();
+    int32_t BasePri_State = StartKernelCriticalSection();
     (*s)++;
 
     if ((*s) < 1)
@@ -89,7 +96,68 @@ void G8RTOS_SignalSemaphore(semaphore_t *s)
 
         thread->blocked = 0;
     }
+    else
+    {
+        // no plain waiter left, wake anyone selecting on this semaphore. The
+        // running thread too, an ISR can land between G8RTOS_WaitAny blocking
+        // it and its yield
+        tcb_t *thread = CurrentlyRunningThread;
+
+        do
+        {
+            if (thread->blocked == &waitAnyBlocked)
+            {
+                for (uint8_t i = 0; i < thread->waitCount; i++)
+                {
+                    if (thread->waitSet[i] == s)
+                    {
+                        thread->waitResult = i;
+                        thread->blocked = 0;
+                        break;
+                    }
+                }
+            }
+
+            thread = thread->nextTCB;
+        } while (thread != CurrentlyRunningThread);
+    }
+
+    EndKernelCriticalSection(BasePri_State);
+}
+
+// G8RTOS_WaitAny
+// Blocks until any semaphore in the set is available. The semaphore is not
+// taken, follow up with G8RTOS_WaitSemaphore (or G8RTOS_ReadFIFO for a FIFO
+// from G8RTOS_GetFIFOSemaphore) on the one returned, which won't block
+// unless another thread got there first.
+// Param "set": array of semaphores to wait on, lower index wins ties
+// Param "count": number of semaphores in the set
+// Return: index of the available semaphore, -1 if the set is empty
+int32_t G8RTOS_WaitAny(semaphore_t *set[], uint8_t count)
+{
+    if (count == 0)
+        return -1;
+
+    int32_t BasePri_State = StartKernelCriticalSection();
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if ((*set[i]) > 0)
+        {
+            EndKernelCriticalSection(BasePri_State);
+            return i;
+        }
+    }
+
+    CurrentlyRunningThread->waitSet = set;
+    CurrentlyRunningThread->waitCount = count;
+    CurrentlyRunningThread->waitResult = -1;
+    CurrentlyRunningThread->blocked = &waitAnyBlocked;
+
+    EndKernelCriticalSection(BasePri_State);
+
+    G8RTOS_Yield();
 
-    EndCriticalSection(IBit_State);
+    return CurrentlyRunningThread->waitResult;
 }
 /********************************Public Functions***********************************/
@@ -0,0 +1,197 @@
+// G8RTOS_Timers.c
+// Date Created: 2023-07-25
+// Date Updated: 2023-07-27
+// Defines for software timer functions
+
+#include "../G8RTOS_Timers.h"
+
+/************************************Includes***************************************/
+
+#include "../G8RTOS_CriticalSection.h"
+#include "../G8RTOS_Scheduler.h"
+
+/************************************Includes***************************************/
+
+/********************************Private Variables***********************************/
+
+static swtimer_t timers[MAX_TIMERS];
+
+// head of the active list, soonest expiry first
+static swtimer_t *activeTimers = 0;
+
+/********************************Private Variables***********************************/
+
+/*******************************Private Functions***********************************/
+
+// wraparound-safe "a expires before b"
+static bool expiresBefore(uint32_t a, uint32_t b)
+{
+    return (int32_t) (a - b) < 0;
+}
+
+// InsertTimer
+// Inserts a timer into the active list, keeping it sorted by expiry.
+// Must be called from inside a critical section.
+static void InsertTimer(swtimer_t *timer)
+{
+    swtimer_t **link = &activeTimers;
+
+    // equal expiries keep insertion order
+    while (*link && !expiresBefore(timer->expiry, (*link)->expiry))
+    {
+        link = &(*link)->nextTimer;
+    }
+
+    timer->nextTimer = *link;
+    *link = timer;
+    timer->active = true;
+}
+
+// RemoveTimer
+// Unlinks a timer from the active list if it's on it.
+// Must be called from inside a critical section.
+static void RemoveTimer(swtimer_t *timer)
+{
+    swtimer_t **link = &activeTimers;
+
+    while (*link && *link != timer)
+    {
+        link = &(*link)->nextTimer;
+    }
+
+    if (*link)
+        *link = timer->nextTimer;
+
+    timer->nextTimer = 0;
+    timer->active = false;
+}
+
+static bool isValidTimer(timerID_t id)
+{
+    return id >= 0 && id < MAX_TIMERS && timers[id].used;
+}
+
+/*******************************Private Functions***********************************/
+
+/********************************Public Functions***********************************/
+
+// G8RTOS_CreateTimer
+// Allocates a timer. The timer is created stopped.
+// Param "callback": function run from the tick when the timer expires
+// Param "period": ms until expiry, and between expiries when auto-reloading
+// Param "mode": one-shot or auto-reload
+// Return: timer id, -1 if no timers are left or the period is 0
+timerID_t G8RTOS_CreateTimer(void (*callback)(void), uint32_t period, timerMode_t mode)
+{
+    if (period == 0)
+        return -1;
+
+    int32_t BasePri_State = StartKernelCriticalSection();
+
+    for (timerID_t i = 0; i < MAX_TIMERS; i++)
+    {
+        if (!timers[i].used)
+        {
+            timers[i].used = true;
+            timers[i].active = false;
+            timers[i].callback = callback;
+            timers[i].period = period;
+            timers[i].mode = mode;
+            timers[i].nextTimer = 0;
+
+            EndKernelCriticalSection(BasePri_State);
+            return i;
+        }
+    }
+
+    EndKernelCriticalSection(BasePri_State);
+    return -1;
+}
+
+// G8RTOS_StartTimer
+// Starts a timer one period from now. Restarts it if already running.
+// Return: 0 if no error, -1 if invalid id
+int32_t G8RTOS_StartTimer(timerID_t id)
+{
+    if (!isValidTimer(id))
+        return -1;
+
+    int32_t BasePri_State = StartKernelCriticalSection();
+
+    if (timers[id].active)
+        RemoveTimer(&timers[id]);
+
+    timers[id].expiry = SystemTime + timers[id].period;
+    InsertTimer(&timers[id]);
+
+    EndKernelCriticalSection(BasePri_State);
+    return 0;
+}
+
+// G8RTOS_StopTimer
+// Stops a timer without running its callback.
+// Return: 0 if no error, -1 if invalid id
+int32_t G8RTOS_StopTimer(timerID_t id)
+{
+    if (!isValidTimer(id))
+        return -1;
+
+    int32_t BasePri_State = StartKernelCriticalSection();
+
+    if (timers[id].active)
+        RemoveTimer(&timers[id]);
+
+    EndKernelCriticalSection(BasePri_State);
+    return 0;
+}
+
+// G8RTOS_ResetTimer
+// Pushes a timer's expiry back to one period from now, e.g. for timeouts
+// that get refreshed by activity.
+// Return: 0 if no error, -1 if invalid id
+int32_t G8RTOS_ResetTimer(timerID_t id)
+{
+    return G8RTOS_StartTimer(id);
+}
+
+bool G8RTOS_TimerActive(timerID_t id)
+{
+    return isValidTimer(id) && timers[id].active;
+}
+
+// G8RTOS_ProcessTimers
+// Runs callbacks of every expired timer. Called from SysTick_Handler. Aperiodic
+// events above SysTick may start and stop timers, so the list is only touched
+// inside a critical section, and the callback runs outside of it.
+// Return: void
+void G8RTOS_ProcessTimers(void)
+{
+    while (true)
+    {
+        int32_t BasePri_State = StartKernelCriticalSection();
+        swtimer_t *timer = activeTimers;
+
+        if (!timer || expiresBefore(SystemTime, timer->expiry))
+        {
+            EndKernelCriticalSection(BasePri_State);
+            return;
+        }
+
+        RemoveTimer(timer);
+
+        // reload relative to the old expiry so periods don't drift
+        if (timer->mode == TIMER_AUTO_RELOAD)
+        {
+            timer->expiry += timer->period;
+            InsertTimer(timer);
+        }
+
+        void (*callback)(void) = timer->callback;
+
+        EndKernelCriticalSection(BasePri_State);
+
+        callback();
+    }
+}
+
+/********************************Public Functions***********************************/
@@ -0,0 +1,24 @@
+//
+// Glyph cache C header file generated by glyphcache.py
+//
+
+#ifndef GLYPHCACHE_H_
+#define GLYPHCACHE_H_
+
+#include <stdint.h>
+#include "fontlibrary.h"
+
+// Index of a glyph that isn't cached
+#define GLYPHCACHE_NONE 0xFF
+
+typedef struct
+{
+    fontStyle_t const *Font;
+    uint8_t const *Index;
+    uint16_t const *Offsets;
+    uint8_t const *Runs;
+} glyphCache_t;
+
+extern const glyphCache_t GlyphCache_Emulogic;
+
+#endif /* GLYPHCACHE_H_ */
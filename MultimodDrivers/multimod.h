@@ -8,8 +8,12 @@
 #include "multimod_PCA9956b.h"
 #include "multimod_ST7789.h"
 #include "multimod_buttons.h"
+#include "multimod_compositor.h"
+#include "multimod_displaylist.h"
+#include "multimod_framepacer.h"
 #include "multimod_i2c.h"
 #include "multimod_joystick.h"
+#include "multimod_numfield.h"
 #include "multimod_spi.h"
 #include "multimod_uart.h"
 
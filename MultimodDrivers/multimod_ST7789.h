@@ -12,6 +12,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include "fontlibrary.h"
+#include "spritelibrary.h"
 
 /************************************Includes***************************************/
 
@@ -80,6 +81,50 @@
 #define X_MAX                       240
 #define Y_MAX                       320
 
+// Fills at least this big go through the uDMA, smaller ones aren't worth
+// blocking the thread for
+#define ST7789_DMA_MIN_PIXELS       256
+
+// SSI frame size used for RAMWR pixel bursts, 8 sends every pixel as two
+// frames (for comparing throughput)
+#define ST7789_PIXEL_FRAME_SIZE     16
+
+// Interface pixel formats (COLMOD). RGB444 sends 12 bits per pixel, 25% less
+// than RGB565, at the cost of colors rounded to 4 bits per field.
+#define ST7789_COLMOD_RGB565        0x55
+#define ST7789_COLMOD_RGB444        0x53
+
+// Pixel format set by ST7789_Init, ST7789_SetColorMode changes it later
+#define ST7789_COLOR_MODE           ST7789_COLMOD_RGB565
+
+// Widest window ST7789_DrawLines fills, its line buffer is on the stack
+#define ST7789_LINE_MAX_PIXELS      64
+
+// Glyphs sent under a single window by ST7789_DrawText
+#define ST7789_TEXT_MAX_GLYPHS      30
+
+// SCK for RAMRD, the ST7789 read cycle is at least 150 ns
+#define ST7789_READ_CLOCK_HZ        6000000
+
+// Fastest write clock ST7789_ProbeClock tries, SysClk / 2 at 80 MHz. The
+// TM4C123 datasheet only rates SSI master mode up to 25 MHz, so above that
+// a rate is only used once RAMRD reads it back right.
+#define ST7789_WRITE_CLOCK_MAX_HZ   40000000
+
+// SCK for commands and their parameters, the ST7789 write cycle is at
+// least 66 ns. Register writes can't be read back to check them, so only
+// pixels are sent faster.
+#define ST7789_COMMAND_CLOCK_HZ     15000000
+
+// Pixels ST7789_ProbeClock writes and reads back, and times per rate
+#define ST7789_PROBE_PIXELS         16
+#define ST7789_PROBE_PASSES         4
+
+// Waits after SLPIN before the next command, and after SLPOUT before the
+// next command or SLPIN
+#define ST7789_SLPIN_DELAY_MS       5
+#define ST7789_SLPOUT_DELAY_MS      120
+
 // COLORS
 #define ST7789_BLACK                0x0000
 #define ST7789_RED                  0x001F
@@ -93,9 +138,45 @@
 /*************************************Defines***************************************/
 
 /******************************Data Type Definitions********************************/
+
+// Fills line with the RGB565 pixels of one row of a window drawn by
+// ST7789_DrawLines, row 0 being the first row of the window.
+typedef void (*st7789Line_t)(const void *context, uint16_t row, uint16_t *line);
+
+// Display modes set by ST7789_SetMode. Partial mode only refreshes the
+// lines set by ST7789_SetPartialArea and blanks the rest, idle mode shows
+// 8 colors (the top bit of each field). Sleep stops refreshing, frame
+// memory is kept and can still be written.
+typedef enum
+{
+    ST7789_MODE_NORMAL = 0,
+    ST7789_MODE_PARTIAL = 1,
+    ST7789_MODE_IDLE = 2,
+    ST7789_MODE_PARTIAL_IDLE = 3,
+    ST7789_MODE_SLEEP = 4
+} st7789Mode_t;
+
 /******************************Data Type Definitions********************************/
 
 /****************************Data Structure Definitions*****************************/
+
+/*
+ *  Pattern:
+ *      - Width x Height tile of RGB565 colors, row 0 first, repeated across
+ *        a window by ST7789_FillPattern starting at its first pixel
+ *      - the outer Edge rows and columns of the tile are drawn once, along
+ *        the sides of the window, and only the middle of the tile repeats,
+ *        e.g. for a frame around the pattern. 0 repeats the whole tile
+ *      - Colors is not copied
+ * */
+typedef struct
+{
+    uint16_t const *Colors;
+    uint8_t Width;
+    uint8_t Height;
+    uint8_t Edge;
+} st7789Pattern_t;
+
 /****************************Data Structure Definitions*****************************/
 
 /***********************************Externs*****************************************/
@@ -107,6 +188,10 @@
 /********************************Public Functions***********************************/
 
 void ST7789_Init();
+uint32_t ST7789_SetWriteClock(uint32_t hz);
+uint32_t ST7789_ProbeClock(void);
+void ST7789_BeginBatch(void);
+void ST7789_EndBatch(void);
 void ST7789_WriteRegister(uint8_t addr, uint8_t data);
 uint8_t ST7789_ReadRegister(uint8_t addr);
 void ST7789_Fill(uint16_t color);
@@ -114,6 +199,24 @@ void ST7789_DrawPixel(uint16_t x, uint16_t y, uint16_t color);
 void ST7789_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color);
 void ST7789_DrawRectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
 void ST7789_DrawOutline(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
+void ST7789_DrawBitmap(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint8_t *data);
+void ST7789_DrawSprite(const sprite_t *sprite, uint16_t x, uint16_t y);
+void ST7789_DrawLines(uint16_t x, uint16_t y, uint16_t w, uint16_t h, st7789Line_t source,
+                      const void *context);
+void ST7789_FillPattern(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                        const st7789Pattern_t *pattern);
+void ST7789_SetScrollArea(uint16_t top, uint16_t height);
+void ST7789_SetScrollStart(uint16_t line);
+void ST7789_SetTearingEffect(bool enable);
+void ST7789_SetPartialArea(uint16_t top, uint16_t height);
+void ST7789_SetMode(st7789Mode_t mode);
+st7789Mode_t ST7789_GetMode(void);
+void ST7789_SetColorMode(uint8_t mode);
+uint8_t ST7789_GetColorMode(void);
+uint16_t ST7789_ToRGB444(uint16_t color);
+uint16_t ST7789_FromRGB444(uint16_t color);
+void ST7789_ConvertPalette(uint16_t *colors, uint16_t count);
+uint16_t ST7789_GetTextWidth(const fontStyle_t *font, const char *text);
 void ST7789_DrawText(const fontStyle_t *font, const char *text, uint16_t x, uint16_t y,
                      uint16_t color, uint16_t bgColor);
 
@@ -0,0 +1,82 @@
+// multimod_compositor.h
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-26
+// Composes a small screen region from rects in RAM and draws it as one
+// window. Only the rects are stored, pixels are produced a line at a time
+// while they are sent, and only the rows that changed since the last
+// submit are redrawn.
+
+#ifndef MULTIMOD_COMPOSITOR_H_
+#define MULTIMOD_COMPOSITOR_H_
+
+/************************************Includes***************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/************************************Includes***************************************/
+
+/*************************************Defines***************************************/
+
+// Rects per composition, later ones are dropped
+#define COMPOSITOR_MAX_RECTS        8
+
+/*************************************Defines***************************************/
+
+/****************************Data Structure Definitions*****************************/
+
+/*
+ *  Compositor Rect:
+ *      - Position relative to the region, already clipped to it
+ * */
+typedef struct compositorRect_t
+{
+    uint8_t x;
+    uint8_t y;
+    uint8_t w;
+    uint8_t h;
+    uint16_t color;
+} compositorRect_t;
+
+/*
+ *  Compositor:
+ *      - Region of at most ST7789_LINE_MAX_PIXELS by 255 pixels, filled
+ *        with background, then the rects in order
+ *      - rects is being composed, drawn is what the last submit sent and
+ *        what the render thread draws from, so it has to stay in place
+ *        until the list has been rendered. Commits and draws replace
+ *        and read it under one lock
+ * */
+typedef struct compositor_t
+{
+    uint16_t x;
+    uint16_t y;
+    uint16_t w;
+    uint16_t h;
+    uint16_t background;
+
+    uint8_t count;
+    compositorRect_t rects[COMPOSITOR_MAX_RECTS];
+
+    bool drawnValid;
+    uint8_t drawnCount;
+    compositorRect_t drawn[COMPOSITOR_MAX_RECTS];
+} compositor_t;
+
+/****************************Data Structure Definitions*****************************/
+
+/********************************Public Functions***********************************/
+
+void Compositor_Init(compositor_t *c, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                     uint16_t background);
+void Compositor_Clear(compositor_t *c);
+void Compositor_Rect(compositor_t *c, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                     uint16_t color);
+void Compositor_Invalidate(compositor_t *c);
+bool Compositor_Commit(compositor_t *c, uint16_t *y, uint16_t *h);
+void Compositor_Submit(compositor_t *c);
+void Compositor_Draw(const compositor_t *c, uint16_t y, uint16_t h);
+
+/********************************Public Functions***********************************/
+
+#endif /* MULTIMOD_COMPOSITOR_H_ */
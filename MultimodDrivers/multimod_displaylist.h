@@ -0,0 +1,132 @@
+// multimod_displaylist.h
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-26
+// Display list for the ST7789. Threads record draw ops, the render thread
+// merges them and draws them in one burst. It is the only thread that
+// draws to the display. Ops are drawn lane by lane where that can't change
+// the result.
+
+#ifndef MULTIMOD_DISPLAYLIST_H_
+#define MULTIMOD_DISPLAYLIST_H_
+
+/************************************Includes***************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "fontlibrary.h"
+#include "multimod_ST7789.h"
+#include "multimod_compositor.h"
+
+/************************************Includes***************************************/
+
+/*************************************Defines***************************************/
+
+// Ops per list, two lists are kept (recording and rendering)
+#define DISPLAYLIST_MAX_OPS         48
+
+// Characters per text op, including the terminator
+#define DISPLAYLIST_TEXT_LEN        12
+
+// Ops of the list each lane leaves free for every lane drawn before it, so
+// a burst of text can't block piece movement on a full list
+#define DISPLAYLIST_LANE_RESERVE    6
+
+/*************************************Defines***************************************/
+
+/******************************Data Type Definitions********************************/
+
+// Display op type
+typedef enum
+{
+    DISPLAYLIST_NOP = 0,
+    DISPLAYLIST_RECT = 1,
+    DISPLAYLIST_OUTLINE = 2,
+    DISPLAYLIST_TEXT = 3,
+    DISPLAYLIST_BLIT = 4,
+    DISPLAYLIST_SCROLL = 5,
+    DISPLAYLIST_COMPOSITE = 6,
+    DISPLAYLIST_MODE = 7,
+    DISPLAYLIST_PATTERN = 8
+} displayOpType_t;
+
+// Display lane, lower lanes are drawn first within a list
+typedef enum
+{
+    DISPLAYLIST_LANE_PIECE = 0,
+    DISPLAYLIST_LANE_BOARD = 1,
+    DISPLAYLIST_LANE_UI = 2,
+    DISPLAYLIST_LANES = 3
+} displayLane_t;
+
+/******************************Data Type Definitions********************************/
+
+/****************************Data Structure Definitions*****************************/
+
+/*
+ *  Display Op:
+ *      - x, y, w, h is the area the op draws to, for text it is measured
+ *        when the op is recorded
+ *      - Text is copied into the op, bitmaps, compositions and patterns
+ *        are not and must stay valid until the list has been rendered
+ *      - Scrolls and mode changes cover the whole screen, so nothing is
+ *        moved across them
+ *      - lane is set from the recording thread's lane
+ * */
+typedef struct displayOp_t
+{
+    uint8_t type;
+    uint16_t x;
+    uint16_t y;
+    uint16_t w;
+    uint16_t h;
+    uint16_t color;
+    uint16_t bgColor;
+    const fontStyle_t *font;
+    uint8_t lane;
+    union
+    {
+        const uint8_t *bitmap;
+        const compositor_t *composite;
+        const st7789Pattern_t *pattern;
+        char text[DISPLAYLIST_TEXT_LEN];
+        struct
+        {
+            uint16_t top;
+            uint16_t height;
+            uint16_t start;
+        } scroll;
+        struct
+        {
+            uint8_t mode;
+            uint16_t top;
+            uint16_t height;
+        } mode;
+    } data;
+} displayOp_t;
+
+/****************************Data Structure Definitions*****************************/
+
+/********************************Public Functions***********************************/
+
+void DisplayList_Rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
+void DisplayList_Outline(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
+void DisplayList_Text(const fontStyle_t *font, const char *text, uint16_t x, uint16_t y,
+                      uint16_t color, uint16_t bgColor);
+void DisplayList_Blit(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint8_t *data);
+void DisplayList_Scroll(uint16_t top, uint16_t height, uint16_t start);
+void DisplayList_Composite(const compositor_t *c, uint16_t y, uint16_t h);
+void DisplayList_Mode(uint8_t mode, uint16_t top, uint16_t height);
+void DisplayList_Pattern(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                         const st7789Pattern_t *pattern);
+void DisplayList_SetLane(displayLane_t lane);
+void DisplayList_Submit(void);
+void DisplayList_Render(void);
+void DisplayList_SetTrace(bool enable);
+
+uint16_t DisplayList_Optimize(displayOp_t *ops, uint16_t count);
+void DisplayList_Prioritize(displayOp_t *ops, uint16_t count);
+
+/********************************Public Functions***********************************/
+
+#endif /* MULTIMOD_DISPLAYLIST_H_ */
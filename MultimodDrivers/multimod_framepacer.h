@@ -0,0 +1,81 @@
+// multimod_framepacer.h
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-26
+// Frame pacing off the ST7789 tearing effect (TE) line. The render thread
+// waits for vsync before drawing a display list, and frame timing is
+// collected for reporting.
+
+#ifndef MULTIMOD_FRAMEPACER_H_
+#define MULTIMOD_FRAMEPACER_H_
+
+/************************************Includes***************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/************************************Includes***************************************/
+
+/*************************************Defines***************************************/
+
+// TE is not routed on the Multimod board, jumper the panel's TE pad here
+#define FRAMEPACER_TE_GPIO_BASE     GPIO_PORTC_BASE
+#define FRAMEPACER_TE_GPIO_PERIPH   SYSCTL_PERIPH_GPIOC
+#define FRAMEPACER_TE_PIN           GPIO_PIN_4
+#define FRAMEPACER_TE_INT           INT_GPIOC
+
+#define FRAMEPACER_PRIORITY         2
+
+// Flushes go ahead without vsync after this long, so a missing TE wire only
+// costs pacing, not the display
+#define FRAMEPACER_TIMEOUT_MS       50
+
+/*************************************Defines***************************************/
+
+/****************************Data Structure Definitions*****************************/
+
+/*
+ *  Frame Pacer Stats:
+ *      - All times in ns, from G8RTOS_GetTimeNs
+ *      - Period is between vsyncs, latency is from the last vsync to the
+ *        start of a flush, interval is between flush starts
+ *      - A flush is late if it is still drawing when the next vsync is due
+ * */
+typedef struct framePacerStats_t
+{
+    uint32_t vsyncs;
+    uint64_t lastVsync;
+    uint32_t periodMin;
+    uint32_t periodMax;
+    uint64_t periodSum;
+
+    uint32_t flushes;
+    uint64_t lastFlush;
+    uint32_t latencyMin;
+    uint32_t latencyMax;
+    uint64_t latencySum;
+    uint32_t intervalMin;
+    uint32_t intervalMax;
+    uint64_t intervalSum;
+    uint32_t durationMax;
+    uint32_t late;
+    uint32_t timeouts;
+} framePacerStats_t;
+
+/****************************Data Structure Definitions*****************************/
+
+/********************************Public Functions***********************************/
+
+void FramePacer_ResetStats(framePacerStats_t *stats);
+void FramePacer_RecordVsync(framePacerStats_t *stats, uint64_t ns);
+void FramePacer_RecordFlush(framePacerStats_t *stats, uint64_t start, uint64_t end);
+uint32_t FramePacer_Jitter(const framePacerStats_t *stats);
+
+void FramePacer_Init(void);
+void FramePacer_WaitVsync(void);
+void FramePacer_EndFrame(void);
+void FramePacer_Report(void);
+void FramePacer_Handler(void);
+
+/********************************Public Functions***********************************/
+
+#endif /* MULTIMOD_FRAMEPACER_H_ */
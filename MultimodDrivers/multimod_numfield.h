@@ -0,0 +1,59 @@
+// multimod_numfield.h
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-26
+// Right aligned number on the display. Remembers the characters it last
+// drew and only records the ones that changed, so a score going from 1195
+// to 1200 redraws three digits instead of the whole number.
+
+#ifndef MULTIMOD_NUMFIELD_H_
+#define MULTIMOD_NUMFIELD_H_
+
+/************************************Includes***************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "fontlibrary.h"
+
+/************************************Includes***************************************/
+
+/*************************************Defines***************************************/
+
+// Digits of the largest uint32_t
+#define NUMFIELD_MAX_DIGITS         10
+
+/*************************************Defines***************************************/
+
+/****************************Data Structure Definitions*****************************/
+
+/*
+ *  Number Field:
+ *      - digits cells of font->FixedWidth pixels starting at x, unused
+ *        leading cells are drawn as spaces
+ *      - drawn is what the last update recorded, 0 for cells that have to
+ *        be drawn again
+ * */
+typedef struct numField_t
+{
+    const fontStyle_t *font;
+    uint16_t x;
+    uint16_t y;
+    uint16_t color;
+    uint16_t bgColor;
+    uint8_t digits;
+    char drawn[NUMFIELD_MAX_DIGITS];
+} numField_t;
+
+/****************************Data Structure Definitions*****************************/
+
+/********************************Public Functions***********************************/
+
+void NumField_Init(numField_t *f, const fontStyle_t *font, uint16_t right, uint16_t y,
+                   uint8_t digits, uint16_t color, uint16_t bgColor);
+void NumField_Invalidate(numField_t *f);
+uint8_t NumField_Format(uint32_t value, char *out, uint8_t digits);
+bool NumField_Set(numField_t *f, uint32_t value);
+
+/********************************Public Functions***********************************/
+
+#endif /* MULTIMOD_NUMFIELD_H_ */
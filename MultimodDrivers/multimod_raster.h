@@ -0,0 +1,35 @@
+// multimod_raster.h
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-26
+// Line and outline rasterizing as runs of pixels. Has no hardware
+// dependencies, the ST7789 driver sends each run as one window and
+// tools/rastercheck draws them into a framebuffer.
+
+#ifndef MULTIMOD_RASTER_H_
+#define MULTIMOD_RASTER_H_
+
+/************************************Includes***************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/************************************Includes***************************************/
+
+/******************************Data Type Definitions********************************/
+
+// Receives a w x h run of pixels, either one row or one column tall. Runs
+// are not clipped to the screen.
+typedef void (*rasterSpan_t)(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
+
+/******************************Data Type Definitions********************************/
+
+/********************************Public Functions***********************************/
+
+void Raster_Line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color,
+                 rasterSpan_t span);
+void Raster_Outline(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color,
+                    rasterSpan_t span);
+
+/********************************Public Functions***********************************/
+
+#endif /* MULTIMOD_RASTER_H_ */
@@ -15,6 +15,7 @@
 #include <inc/hw_gpio.h>
 
 #include <driverlib/ssi.h>
+#include <driverlib/udma.h>
 
 /************************************Includes***************************************/
 
@@ -25,6 +26,17 @@
 #define SPI_A_PIN_MISO      GPIO_PIN_4
 #define SPI_A_PIN_MOSI      GPIO_PIN_5
 #define SPI_A_PIN_CLK       GPIO_PIN_2
+#define SPI_A_DMA_CHANNEL   UDMA_CHANNEL_SSI0TX
+
+// SSI0 clock set by SPI_Init. 80 MHz divides to 40, 20, 13.3, 10 ... MHz,
+// devices change it with SPI_SetClock.
+#define SPI_A_CLOCK_HZ      20000000
+
+// Aperiodic event priority of the uDMA done interrupt
+#define SPI_DMA_PRIORITY        1
+
+// Items per uDMA control structure, hardware limit
+#define SPI_DMA_MAX_ITEMS       1024
 
 /*************************************Defines***************************************/
 
@@ -50,6 +62,20 @@ uint8_t SPI_ReadSingle(uint32_t mod);
 void SPI_WriteMultiple(uint32_t mod, uint32_t* data, uint8_t num_bytes);
 void SPI_ReadMultiple(uint32_t mod, uint32_t* data, uint8_t num_bytes);
 
+void SPI_WaitIdle(uint32_t mod);
+uint32_t SPI_SetClock(uint32_t mod, uint32_t hz);
+uint32_t SPI_GetClock(uint32_t mod);
+void SPI_WriteStream(uint32_t mod, const uint8_t* data, uint32_t num_bytes);
+void SPI_ReadStream(uint32_t mod, uint8_t* data, uint32_t num_bytes);
+void SPI_WriteRepeat16(uint32_t mod, uint16_t value, uint32_t count);
+uint8_t SPI_GetFrameSize(uint32_t mod);
+void SPI_SetFrameSize(uint32_t mod, uint8_t bits);
+
+void SPI_DMA_Init(uint32_t mod);
+void SPI_DMA_Handler(void);
+void SPI_WriteDMA(uint32_t mod, const uint8_t* data, uint32_t num_bytes);
+void SPI_WriteRepeatDMA(uint32_t mod, uint16_t value, uint32_t count);
+
 /********************************Public Functions***********************************/
 
 /*******************************Private Variables***********************************/
@@ -0,0 +1,31 @@
+//
+// Sprite C header file generated by sprite2c.py
+//
+
+#ifndef SPRITELIBRARY_H_
+#define SPRITELIBRARY_H_
+
+#include <stdint.h>
+
+typedef enum
+{
+    SPRITE_RLE565 = 0,
+    SPRITE_INDEXED = 1,
+    SPRITE_INDEXED_RLE = 2
+} spriteFormat_t;
+
+typedef struct
+{
+    uint16_t Width;
+    uint16_t Height;
+    uint8_t Format;
+    uint8_t PaletteSize;
+    uint16_t const *Palette;
+    uint8_t const *Data;
+    uint32_t DataSize;
+} sprite_t;
+
+extern const sprite_t Sprite_Block;
+extern const sprite_t Sprite_Logo;
+
+#endif /* SPRITELIBRARY_H_ */
@@ -0,0 +1,66 @@
+//
+// Glyph cache C source generated by glyphcache.py
+//
+
+#include <stdint.h>
+#include "../glyphcache.h"
+
+// 21 glyphs of Emulogic, " 0123456789CEGHILORSV", 582 bytes of runs (210 bytes as bitmaps)
+static uint8_t const Emulogic_Index[94] = {
+        0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+        0x09, 0x0A, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0B,
+        0xFF, 0x0C, 0xFF, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0x10, 0xFF, 0xFF, 0x11,
+        0xFF, 0xFF, 0x12, 0x13, 0xFF, 0xFF, 0x14, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+static uint16_t const Emulogic_Offsets[21] = {
+        0, 10, 44, 68, 94, 120, 148, 174, 202, 228, 260, 288,
+        316, 340, 370, 406, 430, 454, 488, 522, 550,
+};
+
+static uint8_t const Emulogic_Runs[582] = {
+        8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 2, 3, 3, 1, 2,
+        2, 1, 2, 0, 2, 3, 2, 1, 0, 2, 3, 2, 1, 0, 2, 3,
+        2, 1, 1, 1, 2, 2, 2, 2, 3, 3, 8, 8, 8, 1, 6, 1,
+        3, 2, 3, 3, 2, 3, 3, 2, 3, 3, 2, 3, 2, 3, 3, 3,
+        2, 3, 8, 8, 8, 0, 7, 1, 0, 3, 5, 1, 4, 3, 2, 4,
+        2, 4, 3, 1, 0, 2, 3, 2, 1, 1, 5, 2, 8, 8, 8, 1,
+        5, 2, 0, 2, 3, 2, 1, 5, 2, 1, 2, 4, 2, 3, 2, 3,
+        4, 2, 2, 1, 6, 1, 8, 8, 8, 4, 2, 2, 4, 2, 2, 0,
+        7, 1, 0, 2, 2, 2, 2, 1, 2, 1, 2, 2, 2, 4, 2, 3,
+        3, 2, 8, 8, 8, 1, 5, 2, 0, 2, 3, 2, 1, 5, 2, 1,
+        5, 2, 1, 0, 6, 2, 0, 2, 6, 0, 6, 2, 8, 8, 8, 1,
+        5, 2, 0, 2, 3, 2, 1, 0, 2, 3, 2, 1, 0, 6, 2, 0,
+        2, 6, 1, 2, 5, 2, 4, 2, 8, 8, 8, 2, 2, 4, 2, 2,
+        4, 2, 2, 4, 3, 2, 3, 4, 2, 2, 0, 2, 3, 2, 1, 0,
+        7, 1, 8, 8, 8, 1, 5, 2, 0, 1, 4, 2, 1, 0, 1, 2,
+        4, 1, 1, 4, 3, 0, 3, 2, 1, 2, 0, 2, 3, 1, 2, 1,
+        4, 3, 8, 8, 8, 1, 4, 3, 4, 2, 2, 5, 2, 1, 1, 6,
+        1, 0, 2, 3, 2, 1, 0, 2, 3, 2, 1, 1, 5, 2, 8, 8,
+        8, 2, 4, 2, 1, 2, 2, 2, 1, 0, 2, 6, 0, 2, 6, 0,
+        2, 6, 1, 2, 2, 2, 1, 2, 4, 2, 8, 8, 8, 0, 7, 1,
+        0, 2, 6, 0, 2, 6, 0, 6, 2, 0, 2, 6, 0, 2, 6, 0,
+        7, 1, 8, 8, 8, 2, 5, 1, 1, 2, 2, 2, 1, 0, 2, 3,
+        2, 1, 0, 2, 2, 3, 1, 0, 2, 6, 1, 2, 5, 2, 5, 1,
+        8, 8, 8, 0, 2, 3, 2, 1, 0, 2, 3, 2, 1, 0, 2, 3,
+        2, 1, 0, 7, 1, 0, 2, 3, 2, 1, 0, 2, 3, 2, 1, 0,
+        2, 3, 2, 1, 8, 8, 8, 1, 6, 1, 3, 2, 3, 3, 2, 3,
+        3, 2, 3, 3, 2, 3, 3, 2, 3, 1, 6, 1, 8, 8, 8, 0,
+        7, 1, 0, 2, 6, 0, 2, 6, 0, 2, 6, 0, 2, 6, 0, 2,
+        6, 0, 2, 6, 8, 8, 8, 1, 5, 2, 0, 2, 3, 2, 1, 0,
+        2, 3, 2, 1, 0, 2, 3, 2, 1, 0, 2, 3, 2, 1, 0, 2,
+        3, 2, 1, 1, 5, 2, 8, 8, 8, 0, 2, 2, 3, 1, 0, 2,
+        1, 3, 2, 0, 5, 3, 0, 2, 2, 3, 1, 0, 2, 3, 2, 1,
+        0, 2, 3, 2, 1, 0, 6, 2, 8, 8, 8, 1, 5, 2, 0, 2,
+        3, 2, 1, 5, 2, 1, 1, 5, 2, 0, 2, 6, 0, 2, 2, 2,
+        2, 1, 4, 3, 8, 8, 8, 3, 1, 4, 2, 3, 3, 1, 5, 2,
+        0, 3, 1, 3, 1, 0, 2, 3, 2, 1, 0, 2, 3, 2, 1, 0,
+        2, 3, 2, 1, 8, 8,
+};
+
+const glyphCache_t GlyphCache_Emulogic = { &FontStyle_Emulogic, // Font
+        Emulogic_Index, Emulogic_Offsets, Emulogic_Runs };
@@ -8,6 +8,8 @@
 #include "../multimod_ST7789.h"
 
 #include "../multimod_spi.h"
+#include "../multimod_raster.h"
+#include "../glyphcache.h"
 
 #include <inc/tm4c123gh6pm.h>
 #include <inc/hw_types.h>
@@ -20,6 +22,9 @@
 #include <driverlib/uart.h>
 #include <driverlib/pin_map.h>
 
+#include "../../G8RTOS/G8RTOS_Semaphores.h"
+#include "../../G8RTOS/G8RTOS_Scheduler.h"
+
 /***********************************Macro Defines***********************************/
 #ifndef _swap_int16_t
 #define _swap_int16_t(a, b) \
@@ -30,59 +35,228 @@
 }
 #endif
 
+/*******************************Private Variables***********************************/
+
+// Held from select to deselect. Threads block mid-draw while the uDMA runs,
+// so another thread's window must not be interleaved with it.
+static semaphore_t sem_ST7789 = 1;
+
+// Thread that began a batch, its selects and deselects don't touch CS
+static tcb_t *batchThread = 0;
+static bool batching = false;
+
+// Level of the DC pin. It is only changed when a byte of the other kind
+// is sent, so back to back commands don't toggle it.
+static bool dcData = true;
+
+// Last window sent. CASET and RASET keep their values until changed, so a
+// window sharing the columns or rows of the last one only sends the other.
+static uint16_t windowX0, windowX1, windowY0, windowY1;
+static bool windowValid = false;
+
+// COLMOD the panel is set to, pixels are converted to it as they are queued
+static uint8_t colorMode = ST7789_COLOR_MODE;
+
+// An odd number of RGB444 pixels has been queued since the last command,
+// see ST7789_EndPixels
+static bool oddPixels = false;
+
+// SCK pixels are sent at, see ST7789_ProbeClock. Commands are sent at
+// commandClock, which is never faster.
+static uint32_t writeClock = SPI_A_CLOCK_HZ;
+static uint32_t commandClock = ST7789_COMMAND_CLOCK_HZ;
+
+// SCK last asked of the SSI, so the clock is only changed when the kind of
+// byte sent does
+static uint32_t busClock = SPI_A_CLOCK_HZ;
+
+// Display mode the panel is in, ST7789_SetMode only sends what changes
+static st7789Mode_t displayMode = ST7789_MODE_NORMAL;
+
+// Written and read back by ST7789_ProbeClock. Red and blue are the same in
+// every color, so it reads back the same whichever order RAMRD returns them
+// in, and neighbouring pixels flip as many bits as possible.
+#define ST7789_PROBE_COLOR(rb, g)   ((rb) << 11 | (g) << 5 | (rb))
+static const uint16_t probePattern[8] = { ST7789_PROBE_COLOR(0x15, 0x2A),
+                                          ST7789_PROBE_COLOR(0x0A, 0x15),
+                                          ST7789_PROBE_COLOR(0x1F, 0x3F),
+                                          ST7789_PROBE_COLOR(0x00, 0x00),
+                                          ST7789_PROBE_COLOR(0x15, 0x15),
+                                          ST7789_PROBE_COLOR(0x0A, 0x2A),
+                                          ST7789_PROBE_COLOR(0x1F, 0x00),
+                                          ST7789_PROBE_COLOR(0x00, 0x3F) };
+
+/*******************************Private Variables***********************************/
+
 /********************************Private Functions**********************************/
 
+// ST7789_InBatch
+// Checks if the calling thread began the current batch.
+// Return: bool
+static bool ST7789_InBatch(void)
+{
+    return batching && batchThread == CurrentlyRunningThread;
+}
+
+// ST7789_CountPixels
+// Keeps track of the half byte an odd number of 12-bit pixel frames leaves.
+// Param uint32_t "count": pixels just queued
+// Return: void
+static void ST7789_CountPixels(uint32_t count)
+{
+    if (colorMode == ST7789_COLMOD_RGB444 && (count & 1))
+        oddPixels = !oddPixels;
+}
+
+// ST7789_WriteRepeat
+// Queues count pixels of one value that is already in the current mode.
+// Param uint16_t "value": pixel value
+// Param uint32_t "count": number of pixels
+// Return: void
+static void ST7789_WriteRepeat(uint16_t value, uint32_t count)
+{
+    SPI_WriteRepeat16(SPI_A_BASE, value, count);
+    ST7789_CountPixels(count);
+}
+
+// ST7789_EndPixels
+// Pads the pixel stream to a whole byte with a 4-bit frame. Two RGB444
+// pixels take three bytes, so after an odd number of them the last pixel
+// is still missing half a byte. The panel drops it when CS goes high or
+// the next command starts, and inside a batch the half byte would shift
+// every byte that follows.
+// Return: void
+static void ST7789_EndPixels(void)
+{
+    uint8_t pad = 0;
+
+    if (!oddPixels)
+        return;
+
+    SPI_SetFrameSize(SPI_A_BASE, 4);
+    SPI_WriteStream(SPI_A_BASE, &pad, 1);
+    oddPixels = false;
+}
+
+// ST7789_SetBusClock
+// Changes SCK if it isn't the rate asked for last.
+// Param uint32_t "hz": rate wanted
+// Return: void
+static void ST7789_SetBusClock(uint32_t hz)
+{
+    if (hz == busClock)
+        return;
+
+    SPI_SetClock(SPI_A_BASE, hz);
+    busClock = hz;
+}
+
 // ST7789_Select
-// Selects the ST7789 for SPI transmission.
+// Takes the display and selects the ST7789 for SPI transmission. Inside a
+// batch the display is already selected.
 // Return: void
 void ST7789_Select(void)
 {
+    if (ST7789_InBatch())
+        return;
+
+    G8RTOS_WaitSemaphore(&sem_ST7789);
     GPIOPinWrite(ST7789_PIN_PORT_BASE, ST7789_CS_PIN, 0x00);
 }
 
 // ST7789_Deselect
-// Deselects the ST7789 for SPI transmission.
+// Deselects the ST7789 for SPI transmission and releases the display.
+// Waits for queued data to leave the FIFO first, and leaves the SSI in
+// 8-bit frames for the next command, padded to a whole byte. Inside a
+// batch only the frames are reset, CS stays low until ST7789_EndBatch.
 // Return: void
 void ST7789_Deselect(void)
 {
+    ST7789_EndPixels();
+    SPI_SetFrameSize(SPI_A_BASE, 8);
+    if (ST7789_InBatch())
+        return;
+
+    SPI_WaitIdle(SPI_A_BASE);
     GPIOPinWrite(ST7789_PIN_PORT_BASE, ST7789_CS_PIN, 0xFF);
+    G8RTOS_SignalSemaphore(&sem_ST7789);
 }
 
 // ST7789_SetData
-// Sets the Data/Command pin to data.
+// Sets the Data/Command pin to data. DC is sampled with each byte, so the
+// bus has to be idle before it changes.
 // Return: void
 void ST7789_SetData(void)
 {
+    if (dcData)
+        return;
+
+    SPI_WaitIdle(SPI_A_BASE);
     GPIOPinWrite(ST7789_PIN_PORT_BASE, ST7789_DC_PIN, 0xFF);
+    dcData = true;
 }
 
 // ST7789_SetCommand
-// Sets the Data/Command pin to command.
+// Sets the Data/Command pin to command, waiting for the bus to go idle
+// if it changes.
 // Return: void
 void ST7789_SetCommand(void)
 {
+    if (!dcData)
+        return;
+
+    SPI_WaitIdle(SPI_A_BASE);
     GPIOPinWrite(ST7789_PIN_PORT_BASE, ST7789_DC_PIN, 0x00);
+    dcData = false;
 }
 
 // ST7789_WriteCommand
 // Similar to BMI160, writes to specify which register that data
-// will be sent to.
+// will be sent to. DC is left low, the first data byte or pixel after it
+// switches it back. The command and its parameters go out at the command
+// clock.
 // Param uint8_t "cmd": command register to send data to.
 // Return: void
 void ST7789_WriteCommand(uint8_t cmd)
 {
+    ST7789_EndPixels();
+    SPI_SetFrameSize(SPI_A_BASE, 8);
     ST7789_SetCommand();
-    SPI_WriteSingle(SPI_A_BASE, cmd);
-    ST7789_SetData();
+    ST7789_SetBusClock(commandClock);
+    SPI_WriteStream(SPI_A_BASE, &cmd, 1);
 }
 
 // ST7789_WriteData
-// Sends data to register specified by CMD.
+// Sends data to register specified by CMD. Only queues the byte.
 // Param uint8_t "data": data to be sent.
 // Return: void
 void ST7789_WriteData(uint8_t data)
 {
-    SPI_WriteSingle(SPI_A_BASE, data);
+    ST7789_SetData();
+    SPI_WriteStream(SPI_A_BASE, &data, 1);
+}
+
+// ST7789_BeginPixels
+// Switches to pixel sized frames after RAMWR, so each pixel is a single
+// FIFO write. RGB444 pixels are sent as 12-bit frames, which the SSI shifts
+// out back to back, two pixels to three bytes. WriteCommand and Deselect
+// switch back to 8 bits. Pixels go out at the write clock.
+// Return: void
+void ST7789_BeginPixels(void)
+{
+    ST7789_SetData();
+    ST7789_SetBusClock(writeClock);
+    SPI_SetFrameSize(SPI_A_BASE,
+                     colorMode == ST7789_COLMOD_RGB444 ? 12 : ST7789_PIXEL_FRAME_SIZE);
+}
+
+// ST7789_PixelValue
+// Converts an RGB565 color to what is sent for it in the current mode.
+// Param uint16_t "color": RGB565 color.
+// Return: uint16_t
+uint16_t ST7789_PixelValue(uint16_t color)
+{
+    return colorMode == ST7789_COLMOD_RGB444 ? ST7789_ToRGB444(color) : color;
 }
 
 // ST7789_ReadRegister
@@ -94,7 +268,8 @@ uint8_t ST7789_ReadRegister(uint8_t data)
 }
 
 // ST7789_SetWindow
-// Sets windows subsequent pixels will be generated at.
+// Sets windows subsequent pixels will be generated at. The column or row
+// range is only sent if it changed since the last window.
 // Param int16_t x: x-coord of first corner.
 // Param int16_t y: y-coord of first corner.
 // Param int16_t w: width of window.
@@ -108,18 +283,30 @@ void ST7789_SetWindow(int16_t x, int16_t y, int16_t w, int16_t h)
     if (x >= 0 && (x + w - 1) < X_MAX && y >= 0 && (y + h - 1) < Y_MAX)
     {
         // Set column address (x + w);
-        ST7789_WriteCommand(ST7789_CASET_ADDR);
-        ST7789_WriteData(x >> 8 & 0xFF);
-        ST7789_WriteData(x & 0xFF);
-        ST7789_WriteData((x + w - 1) >> 8 & 0xFF);
-        ST7789_WriteData((x + w - 1) & 0xFF);
+        if (!windowValid || x != windowX0 || x + w - 1 != windowX1)
+        {
+            ST7789_WriteCommand(ST7789_CASET_ADDR);
+            ST7789_WriteData(x >> 8 & 0xFF);
+            ST7789_WriteData(x & 0xFF);
+            ST7789_WriteData((x + w - 1) >> 8 & 0xFF);
+            ST7789_WriteData((x + w - 1) & 0xFF);
+            windowX0 = x;
+            windowX1 = x + w - 1;
+        }
 
         // Set row address
-        ST7789_WriteCommand(ST7789_RASET_ADDR);
-        ST7789_WriteData(y >> 8 & 0xFF);
-        ST7789_WriteData(y & 0xFF);
-        ST7789_WriteData((y + h - 1) >> 8 & 0xFF);
-        ST7789_WriteData((y + h - 1) & 0xFF);
+        if (!windowValid || y != windowY0 || y + h - 1 != windowY1)
+        {
+            ST7789_WriteCommand(ST7789_RASET_ADDR);
+            ST7789_WriteData(y >> 8 & 0xFF);
+            ST7789_WriteData(y & 0xFF);
+            ST7789_WriteData((y + h - 1) >> 8 & 0xFF);
+            ST7789_WriteData((y + h - 1) & 0xFF);
+            windowY0 = y;
+            windowY1 = y + h - 1;
+        }
+
+        windowValid = true;
 
         // Set register to write to as memory
         ST7789_WriteCommand(ST7789_RAMWR_ADDR);
@@ -137,17 +324,12 @@ void ST7789_DrawVLine(uint16_t x, uint16_t y, uint16_t h, uint16_t color)
 {
     if ((x < X_MAX) && (y < Y_MAX) && h)
     {
-        uint8_t color_hi = color >> 8, color_lo = color;
         if ((y + h - 1) >= Y_MAX)
             h = Y_MAX - y;
         ST7789_Select();
         ST7789_SetWindow(x, y, 1, h);
-        while (h--)
-        {
-            ST7789_WriteData(color_hi);
-            ST7789_WriteData(color_lo);
-        }
-
+        ST7789_BeginPixels();
+        ST7789_WriteRepeat(ST7789_PixelValue(color), h);
         ST7789_Deselect();
     }
 }
@@ -163,26 +345,43 @@ void ST7789_DrawHLine(uint16_t x, uint16_t y, uint16_t w, uint16_t color)
 {
     if ((x < X_MAX) && (y < Y_MAX) && w)
     {
-        uint8_t color_hi = color >> 8, color_lo = color;
-
-        if ((x >= X_MAX) || (y >= Y_MAX))
-            return;
         if ((x + w - 1) >= X_MAX)
             w = X_MAX - x;
         ST7789_Select();
         ST7789_SetWindow(x, y, w, 1);
-        while (w--)
-        {
-            ST7789_WriteData(color_hi);
-            ST7789_WriteData(color_lo);
-        }
-
+        ST7789_BeginPixels();
+        ST7789_WriteRepeat(ST7789_PixelValue(color), w);
         ST7789_Deselect();
     }
 }
 
+// ST7789_Span
+// Draws a run from the rasterizer as one window, clipped to the screen.
+// The display must already be selected.
+// Param uint16_t x: x-coord of first pixel.
+// Param uint16_t y: y-coord of first pixel.
+// Param uint16_t w: width of run.
+// Param uint16_t h: height of run.
+// Param uint16_t color: color of run.
+// Return: void
+void ST7789_Span(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+    if (x >= X_MAX || y >= Y_MAX || !w || !h)
+        return;
+
+    if (x + w > X_MAX)
+        w = X_MAX - x;
+    if (y + h > Y_MAX)
+        h = Y_MAX - y;
+
+    ST7789_SetWindow(x, y, w, h);
+    ST7789_BeginPixels();
+    ST7789_WriteRepeat(ST7789_PixelValue(color), (uint32_t) w * h);
+}
+
 // ST7789_Line
-// Draws a line from point 1 to point 2.
+// Draws a line from point 1 to point 2, one window per horizontal (or
+// vertical, for steep lines) run of pixels.
 // Param uint16_t x0: x-coord of first point.
 // Param uint16_t y0: y-coord of first point.
 // Param uint16_t x1: x-coord of second point.
@@ -191,62 +390,123 @@ void ST7789_DrawHLine(uint16_t x, uint16_t y, uint16_t w, uint16_t color)
 // Return: void
 void ST7789_Line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color)
 {
-    bool steep = abs((int16_t) (y1 - y0)) > abs((int16_t) (x1 - x0));
-    if (steep)
-    {
-        _swap_int16_t(x0, y0);
-        _swap_int16_t(x1, y1);
-    }
-
-    if (x0 > x1)
-    {
-        _swap_int16_t(x0, x1);
-        _swap_int16_t(y0, y1);
-    }
+    ST7789_Select();
+    Raster_Line(x0, y0, x1, y1, color, ST7789_Span);
+    ST7789_Deselect();
+}
 
-    int16_t dx, dy;
-    dx = x1 - x0;
-    dy = abs((int16_t) (y1 - y0));
+// delay_ms
+// Software delay.
+// Param: uint32_t "ms": number of milliseconds to delay.
+// Return: void
+void delay_ms(uint32_t ms)
+{
+    SysCtlDelay((SysCtlClockGet() / (3 * 1000)) * ms + 1);
+}
 
-    int16_t err = dx / 2;
-    int16_t ystep;
+// ST7789_PutRun
+// Queues count pixels of one color. Runs long enough to be worth it go
+// through the uDMA.
+// Return: void
+void ST7789_PutRun(uint16_t color, uint32_t count)
+{
+    color = ST7789_PixelValue(color);
 
-    if (y0 < y1)
+    if (count >= ST7789_DMA_MIN_PIXELS)
     {
-        ystep = 1;
+        SPI_WriteRepeatDMA(SPI_A_BASE, color, count);
     }
     else
     {
-        ystep = -1;
+        SPI_WriteRepeat16(SPI_A_BASE, color, count);
     }
 
-    for (; x0 <= x1; x0++)
+    ST7789_CountPixels(count);
+}
+
+// ST7789_ReadRaw
+// Reads frame memory of a window with RAMRD at ST7789_READ_CLOCK_HZ. The
+// panel sends 3 bytes per pixel, 6 bits per field, after a dummy clock,
+// so the bytes are returned as they came off the bus.
+// Param uint8_t* "bytes": buffer for count bytes
+// Return: void
+static void ST7789_ReadRaw(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t *bytes,
+                           uint16_t count)
+{
+    ST7789_Select();
+    ST7789_SetWindow(x, y, w, h);
+    ST7789_WriteCommand(ST7789_RAMRD_ADDR);
+    ST7789_SetData();
+    ST7789_SetBusClock(ST7789_READ_CLOCK_HZ);
+    SPI_ReadStream(SPI_A_BASE, bytes, count);
+    ST7789_Deselect();
+}
+
+// ST7789_FindPattern
+// Checks if the probe pattern, starting at entry first, was read back.
+// It is looked for at every bit offset up to 15, to not depend on how many
+// dummy clocks come first. Only the bits RGB565 sets are compared.
+// Param uint8_t* "bytes": 3 * ST7789_PROBE_PIXELS + 2 bytes from RAMRD
+// Return: bool
+static bool ST7789_FindPattern(const uint8_t *bytes, uint8_t first)
+{
+    for (uint8_t shift = 0; shift < 16; shift++)
     {
-        if (steep)
-        {
-            ST7789_DrawPixel(y0, x0, color);
-        }
-        else
-        {
-            ST7789_DrawPixel(x0, y0, color);
-        }
+        uint16_t i;
 
-        err -= dy;
-        if (err < 0)
+        for (i = 0; i < ST7789_PROBE_PIXELS; i++)
         {
-            y0 += ystep;
-            err += dx;
+            uint16_t color = probePattern[(i + first) % 8], got = 0;
+
+            for (uint8_t field = 0; field < 3; field++)
+            {
+                uint16_t bit = shift + (i * 3 + field) * 8;
+                uint8_t byte = (bytes[bit >> 3] << 8 | bytes[(bit >> 3) + 1]) >> (8 - (bit & 7));
+
+                got = field == 1 ? got << 6 | byte >> 2 : got << 5 | byte >> 3;
+            }
+
+            if (got != color)
+                break;
         }
+
+        if (i == ST7789_PROBE_PIXELS)
+            return true;
     }
+
+    return false;
 }
 
-// delay_ms
-// Software delay.
-// Param: uint32_t "ms": number of milliseconds to delay.
-// Return: void
-void delay_ms(uint32_t ms)
+// ST7789_TestClock
+// Writes the probe pattern at a write clock and reads it back. The clock
+// is left set. After a failed rate the window isn't trusted to be what was
+// last sent.
+// Param uint32_t "hz": write clock to test
+// Return: bool, true if every pass read back right
+static bool ST7789_TestClock(uint32_t hz)
 {
-    SysCtlDelay((SysCtlClockGet() / (3 * 1000)) * ms + 1);
+    uint8_t bytes[3 * ST7789_PROBE_PIXELS + 2];
+
+    ST7789_SetWriteClock(hz);
+
+    for (uint8_t pass = 0; pass < ST7789_PROBE_PASSES; pass++)
+    {
+        ST7789_Select();
+        ST7789_SetWindow(0, 0, ST7789_PROBE_PIXELS, 1);
+        ST7789_BeginPixels();
+        for (uint8_t i = 0; i < ST7789_PROBE_PIXELS; i++)
+            ST7789_WriteRepeat(probePattern[(i + pass) % 8], 1);
+        ST7789_Deselect();
+
+        ST7789_ReadRaw(0, 0, ST7789_PROBE_PIXELS, 1, bytes, sizeof(bytes));
+        if (!ST7789_FindPattern(bytes, pass))
+        {
+            windowValid = false;
+            return false;
+        }
+    }
+
+    return true;
 }
 
 /********************************Public Functions***********************************/
@@ -260,18 +520,22 @@ void ST7789_Init()
     GPIOPinTypeGPIOOutput(ST7789_PIN_PORT_BASE, ST7789_CS_PIN);
     GPIOPinTypeGPIOOutput(ST7789_PIN_PORT_BASE, ST7789_DC_PIN);
     SPI_Init(SPI_A_BASE);
+    busClock = SPI_A_CLOCK_HZ;
 
-    ST7789_Deselect();
+    GPIOPinWrite(ST7789_PIN_PORT_BASE, ST7789_CS_PIN, 0xFF);
+    GPIOPinWrite(ST7789_PIN_PORT_BASE, ST7789_DC_PIN, 0xFF);
+    dcData = true;
 
     // Do software reset first
     ST7789_Select();
 
     ST7789_WriteCommand(ST7789_SWRESET_ADDR);
+    windowValid = false;
     delay_ms(120);
     ST7789_WriteCommand(ST7789_SLPOUT_ADDR);
     delay_ms(500);
     ST7789_WriteCommand(ST7789_COLMOD_ADDR);
-    ST7789_WriteData(0x55);
+    ST7789_WriteData(colorMode);
 
     ST7789_WriteCommand(ST7789_CASET_ADDR);
     ST7789_WriteData(0x00);
@@ -296,6 +560,7 @@ void ST7789_Init()
     ST7789_WriteData(0b01001000);
 
     ST7789_WriteCommand(ST7789_NORON_ADDR);
+    displayMode = ST7789_MODE_NORMAL;
     delay_ms(120);
 
     ST7789_WriteCommand(ST7789_INVON_ADDR);
@@ -303,10 +568,105 @@ void ST7789_Init()
 
     ST7789_WriteCommand(ST7789_DISPON_ADDR);
     delay_ms(120);
+    ST7789_Deselect();
+
     ST7789_Fill(0x0000);
+}
+
+// ST7789_SetWriteClock
+// Sets the SCK pixels are sent at. Commands are sent at the slower of it
+// and ST7789_COMMAND_CLOCK_HZ.
+// Param uint32_t "hz": fastest rate wanted, rounded down to one the SSI
+// can divide to
+// Return: uint32_t, rate set
+uint32_t ST7789_SetWriteClock(uint32_t hz)
+{
+    writeClock = SPI_SetClock(SPI_A_BASE, hz);
+    commandClock = writeClock < ST7789_COMMAND_CLOCK_HZ ? writeClock : ST7789_COMMAND_CLOCK_HZ;
+    busClock = writeClock;
+    return writeClock;
+}
+
+// ST7789_BeginBatch
+// Selects the display once for a run of draw calls from the calling
+// thread, which then share a single CS assertion. Other threads that draw
+// wait for ST7789_EndBatch. Batches don't nest.
+// Return: void
+void ST7789_BeginBatch(void)
+{
+    if (ST7789_InBatch())
+        return;
+
+    ST7789_Select();
+    batchThread = CurrentlyRunningThread;
+    batching = true;
+}
+
+// ST7789_EndBatch
+// Deselects the display at the end of a batch.
+// Return: void
+void ST7789_EndBatch(void)
+{
+    if (!ST7789_InBatch())
+        return;
+
+    batching = false;
     ST7789_Deselect();
 }
 
+// ST7789_ProbeClock
+// Finds the fastest write clock the panel takes reliably. Starting slow,
+// each rate the SSI can divide to is tested by writing a pattern to the
+// first pixels of the screen and reading it back with RAMRD at
+// ST7789_READ_CLOCK_HZ. The first rate that fails ends the search. If the
+// last one that passed is faster than SPI_A_CLOCK_HZ it was close to
+// failing, so the next slower one is kept, but never less than
+// SPI_A_CLOCK_HZ. Stopping at ST7789_WRITE_CLOCK_MAX_HZ keeps the last rate.
+// If even the slowest rate fails RAMRD can't be read (e.g. MISO isn't
+// connected) and SPI_A_CLOCK_HZ is kept. Meant for startup, the tested
+// pixels are cleared to black after.
+// Return: uint32_t, write clock set
+uint32_t ST7789_ProbeClock(void)
+{
+    uint32_t sysClock = SysCtlClockGet(), best = 0;
+    uint8_t mode = colorMode, divide;
+
+    if (mode != ST7789_COLMOD_RGB565)
+        ST7789_SetColorMode(ST7789_COLMOD_RGB565);
+
+    // SysClk / 16 up to SysClk / 2
+    for (divide = 8; divide; divide--)
+    {
+        uint32_t hz = sysClock / (2 * divide);
+
+        if (hz > ST7789_WRITE_CLOCK_MAX_HZ)
+            break;
+
+        if (!ST7789_TestClock(hz))
+        {
+            // only back off from a rate the driver didn't already run at
+            if (best > SPI_A_CLOCK_HZ)
+            {
+                best = sysClock / (2 * (divide + 2));
+                if (best < SPI_A_CLOCK_HZ)
+                    best = SPI_A_CLOCK_HZ;
+            }
+            break;
+        }
+
+        best = hz;
+    }
+
+    ST7789_SetWriteClock(best ? best : SPI_A_CLOCK_HZ);
+
+    if (mode != ST7789_COLMOD_RGB565)
+        ST7789_SetColorMode(mode);
+
+    ST7789_DrawRectangle(0, 0, ST7789_PROBE_PIXELS, 1, ST7789_BLACK);
+
+    return writeClock;
+}
+
 // ST7789_DrawPixel
 // Draws a pixel of color at x, y.
 // Param uint16_t "x": x-axis of pixel.
@@ -321,9 +681,9 @@ void ST7789_DrawPixel(uint16_t x, uint16_t y, uint16_t color)
         ST7789_Select();
         // Set window
         ST7789_SetWindow(x, y, 1, 1);
+        ST7789_BeginPixels();
         // Set color
-        ST7789_WriteData((color >> 8) & 0xFF);
-        ST7789_WriteData(color & 0xFF);
+        ST7789_WriteRepeat(ST7789_PixelValue(color), 1);
         ST7789_Deselect();
     }
 }
@@ -367,7 +727,8 @@ void ST7789_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_
 }
 
 // ST7789_DrawRectangle
-// Draws a rectangle.
+// Draws a rectangle, clipped to the screen. Without a window the pixels
+// would carry on into the last one.
 // Param uint16_t x: x-coord of first point.
 // Param uint16_t y: y-coord of first point.
 // Param uint16_t w: width of rectangle
@@ -376,84 +737,605 @@ void ST7789_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_
 // Return: void
 void ST7789_DrawRectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
 {
-    uint8_t color_hi, color_lo;
+    if (x >= X_MAX || y >= Y_MAX || !w || !h)
+        return;
+
+    if (x + w > X_MAX)
+        w = X_MAX - x;
+    if (y + h > Y_MAX)
+        h = Y_MAX - y;
+
     ST7789_Select();
     ST7789_SetWindow(x, y, w, h);
+    ST7789_BeginPixels();
+    ST7789_PutRun(color, (uint32_t) w * (uint32_t) h);
+    ST7789_Deselect();
+}
 
-    color_hi = color >> 8;
-    color_lo = color & 0xFF;
+// ST7789_DrawBitmap
+// Draws a bitmap, sent in the background by the uDMA. In RGB444 mode every
+// pixel has to be converted, so it goes through the TX FIFO instead.
+// Bitmaps that don't fit on the screen aren't drawn.
+// Param uint16_t x: x-coord of first point.
+// Param uint16_t y: y-coord of first point.
+// Param uint16_t w: width of bitmap.
+// Param uint16_t h: height of bitmap.
+// Param uint8_t* data: w * h RGB565 pixels, high byte first.
+// Return: void
+void ST7789_DrawBitmap(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint8_t *data)
+{
+    uint32_t pixels = (uint32_t) w * (uint32_t) h;
+
+    if (!pixels || x + w > X_MAX || y + h > Y_MAX)
+        return;
 
-    uint32_t num_p = (uint32_t) w * (uint32_t) h;
-    while (num_p--)
+    ST7789_Select();
+    ST7789_SetWindow(x, y, w, h);
+
+    if (colorMode == ST7789_COLMOD_RGB444)
+    {
+        ST7789_BeginPixels();
+        for (; pixels; pixels--, data += 2)
+            ST7789_WriteRepeat(ST7789_ToRGB444(data[0] << 8 | data[1]), 1);
+    }
+    else
     {
-        ST7789_WriteData(color_hi);
-        ST7789_WriteData(color_lo);
+        // the uDMA sends bytes, so the frames are left at 8 bits
+        ST7789_SetData();
+        ST7789_SetBusClock(writeClock);
+        SPI_WriteDMA(SPI_A_BASE, data, pixels * 2);
     }
+
     ST7789_Deselect();
 }
 
-void ST7789_DrawOutline(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+// ST7789_DrawSprite
+// Draws a sprite from spritelibrary, decoding it straight into the SPI
+// stream. Neighbouring runs of the same color are sent as one run.
+// Sprites that don't fit on the screen aren't drawn.
+// Param sprite_t* sprite: sprite to draw.
+// Param uint16_t x: x-coord of top left corner.
+// Param uint16_t y: y-coord of top left corner.
+// Return: void
+void ST7789_DrawSprite(const sprite_t *sprite, uint16_t x, uint16_t y)
 {
-    ST7789_DrawLine(x, y, x + w - 1, y, color);
-    ST7789_DrawLine(x, y, x, y + h - 1, color);
-    ST7789_DrawLine(x, y + h - 1, x + w - 1, y + h - 1, color);
-    ST7789_DrawLine(x + w - 1, y, x + w - 1, y + h - 1, color);
+    const uint8_t *data = sprite->Data;
+    const uint8_t *end = data + sprite->DataSize;
+    uint32_t pixels = (uint32_t) sprite->Width * sprite->Height;
+    uint32_t count, run = 0;
+    uint16_t color = 0, next;
+    bool low = false;
+
+    if (!pixels || x + sprite->Width > X_MAX || y + sprite->Height > Y_MAX)
+        return;
+
+    ST7789_Select();
+    ST7789_SetWindow(x, y, sprite->Width, sprite->Height);
+    ST7789_BeginPixels();
+
+    while (pixels && data < end)
+    {
+        switch (sprite->Format)
+        {
+        case SPRITE_RLE565:
+            count = data[0] + 1;
+            next = data[1] << 8 | data[2];
+            data += 3;
+            break;
+        case SPRITE_INDEXED_RLE:
+            count = (data[0] >> 4) + 1;
+            next = sprite->Palette[data[0] & 0x0F];
+            data++;
+            break;
+        default:
+            // two pixels per byte, high nibble first
+            count = 1;
+            next = sprite->Palette[low ? *data++ & 0x0F : *data >> 4];
+            low = !low;
+            break;
+        }
+
+        if (count > pixels)
+            count = pixels;
+        pixels -= count;
+
+        if (run && next != color)
+        {
+            ST7789_PutRun(color, run);
+            run = 0;
+        }
+
+        color = next;
+        run += count;
+    }
+
+    if (run)
+        ST7789_PutRun(color, run);
+
+    ST7789_Deselect();
 }
 
-const uint8_t* ST7789_GetCharGlyph(const fontStyle_t *font, char c)
+// ST7789_DrawLines
+// Draws a window whose pixels are produced a line at a time, e.g. by
+// compositing them in RAM. Neighbouring runs of the same color are sent as
+// one run, also across lines. Windows that don't fit on the screen or are
+// wider than ST7789_LINE_MAX_PIXELS aren't drawn.
+// Param uint16_t x: x-coord of top left corner.
+// Param uint16_t y: y-coord of top left corner.
+// Param uint16_t w: width of window.
+// Param uint16_t h: height of window.
+// Param st7789Line_t source: fills in each line.
+// Param void* context: passed to source.
+// Return: void
+void ST7789_DrawLines(uint16_t x, uint16_t y, uint16_t w, uint16_t h, st7789Line_t source,
+                      const void *context)
+{
+    uint16_t line[ST7789_LINE_MAX_PIXELS];
+    uint16_t color = 0;
+    uint32_t run = 0;
+
+    if (!w || !h || w > ST7789_LINE_MAX_PIXELS || x + w > X_MAX || y + h > Y_MAX)
+        return;
+
+    ST7789_Select();
+    ST7789_SetWindow(x, y, w, h);
+    ST7789_BeginPixels();
+
+    for (uint16_t row = 0; row < h; row++)
+    {
+        source(context, row, line);
+
+        for (uint16_t i = 0; i < w; i++)
+        {
+            if (run && line[i] != color)
+            {
+                ST7789_PutRun(color, run);
+                run = 0;
+            }
+
+            color = line[i];
+            run++;
+        }
+    }
+
+    ST7789_PutRun(color, run);
+    ST7789_Deselect();
+}
+
+// ST7789_PatternIndex
+// Tile row or column of a window row or column, the edges of the tile
+// only land on the edges of the window.
+// Param uint16_t i: row or column of the window.
+// Param uint16_t n: height or width of the window.
+// Param uint8_t size: height or width of the tile.
+// Param uint8_t edge: edge of the tile.
+// Return: uint8_t
+static uint8_t ST7789_PatternIndex(uint16_t i, uint16_t n, uint8_t size, uint8_t edge)
 {
-    int low = 0;
-    int high = font->GlyphCount - 1;
+    if (i < edge)
+        return i;
+    if (i >= n - edge)
+        return size - (n - i);
+    return edge + (i - edge) % (size - 2 * edge);
+}
 
-    while (low <= high)
+// ST7789_FillPattern
+// Fills a window with a repeated tile, sent as one window. Neighbouring
+// pixels of the same color are sent as one run, also across rows, so long
+// runs go through the uDMA.
+// Windows that don't fit on the screen or are smaller than the edges of
+// the tile aren't drawn.
+// Param uint16_t x: x-coord of top left corner.
+// Param uint16_t y: y-coord of top left corner.
+// Param uint16_t w: width of window.
+// Param uint16_t h: height of window.
+// Param st7789Pattern_t* pattern: tile, its first pixel lands on x, y.
+// Return: void
+void ST7789_FillPattern(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                        const st7789Pattern_t *pattern)
+{
+    uint8_t edge = pattern->Edge;
+    uint16_t color = 0;
+    uint32_t run = 0;
+
+    if (!w || !h || pattern->Width <= 2 * edge || pattern->Height <= 2 * edge || w < 2 * edge
+            || h < 2 * edge || x + w > X_MAX || y + h > Y_MAX)
+        return;
+
+    ST7789_Select();
+    ST7789_SetWindow(x, y, w, h);
+    ST7789_BeginPixels();
+
+    for (uint16_t row = 0; row < h; row++)
     {
-        int mid = low + (high - low) / 2;
-        char midChar = font->FirstAsciiCode + mid;
-
-        if (midChar < c)
-            low = mid + 1;
-        else if (midChar > c)
-            high = mid - 1;
-        else
+        const uint16_t *tile = &pattern->Colors[ST7789_PatternIndex(row, h, pattern->Height,
+                                                                    edge) * pattern->Width];
+        uint8_t i = 0;
+
+        for (uint16_t column = 0; column < w; column++)
         {
-            // Found the glyph
-            return &(font->GlyphBitmaps[(mid + 1) * font->GlyphBytesWidth * font->GlyphHeight
-                    - font->GlyphBytesWidth]);
+            if (run && tile[i] != color)
+            {
+                ST7789_PutRun(color, run);
+                run = 0;
+            }
+
+            color = tile[i];
+            run++;
+
+            // the right edge of the tile takes over at the right edge of
+            // the window, before that the middle wraps around
+            if (column + 1 == w - edge)
+                i = pattern->Width - edge;
+            else if (++i == pattern->Width - edge)
+                i = edge;
         }
     }
 
-    // Glyph not found
-    return NULL;
+    ST7789_PutRun(color, run);
+    ST7789_Deselect();
+}
+
+// ST7789_SetScrollArea
+// Defines the band of lines that vertical scrolling moves, the lines
+// above and below it stay fixed.
+// Param uint16_t top: first line of the band.
+// Param uint16_t height: number of lines in the band.
+// Return: void
+void ST7789_SetScrollArea(uint16_t top, uint16_t height)
+{
+    uint16_t bottom = Y_MAX - top - height;
+
+    ST7789_Select();
+    ST7789_WriteCommand(ST7789_VSCRDEF_ADDR);
+    ST7789_WriteData(top >> 8 & 0xFF);
+    ST7789_WriteData(top & 0xFF);
+    ST7789_WriteData(height >> 8 & 0xFF);
+    ST7789_WriteData(height & 0xFF);
+    ST7789_WriteData(bottom >> 8 & 0xFF);
+    ST7789_WriteData(bottom & 0xFF);
+    ST7789_Deselect();
+}
+
+// ST7789_SetScrollStart
+// Sets which frame memory line is shown on the first line of the scroll
+// band, the rest of the band follows and wraps around within it.
+// Param uint16_t line: frame memory line, between top and top + height.
+// Return: void
+void ST7789_SetScrollStart(uint16_t line)
+{
+    ST7789_Select();
+    ST7789_WriteCommand(ST7789_VSCRSADD_ADDR);
+    ST7789_WriteData(line >> 8 & 0xFF);
+    ST7789_WriteData(line & 0xFF);
+    ST7789_Deselect();
+}
+
+// ST7789_SetTearingEffect
+// Turns the TE output on or off. When on it pulses high during vblank
+// only, marking the start of each refresh.
+// Param bool enable: TE output on.
+// Return: void
+void ST7789_SetTearingEffect(bool enable)
+{
+    ST7789_Select();
+    if (enable)
+    {
+        ST7789_WriteCommand(ST7789_TEON_ADDR);
+        ST7789_WriteData(0x00);
+    }
+    else
+    {
+        ST7789_WriteCommand(ST7789_TEOFF_ADDR);
+    }
+    ST7789_Deselect();
+}
+
+// ST7789_SetPartialArea
+// Sets the lines refreshed in partial mode, in the same line addresses
+// as the scroll area. Can be changed while in partial mode.
+// Param uint16_t top: first line of the area.
+// Param uint16_t height: number of lines in the area.
+// Return: void
+void ST7789_SetPartialArea(uint16_t top, uint16_t height)
+{
+    uint16_t end = top + height - 1;
+
+    ST7789_Select();
+    ST7789_WriteCommand(ST7789_PTLAR_ADDR);
+    ST7789_WriteData(top >> 8 & 0xFF);
+    ST7789_WriteData(top & 0xFF);
+    ST7789_WriteData(end >> 8 & 0xFF);
+    ST7789_WriteData(end & 0xFF);
+    ST7789_Deselect();
 }
 
+// ST7789_SetMode
+// Moves the panel to a display mode, sending only the commands for what
+// changes. Waking from sleep blocks for ST7789_SLPOUT_DELAY_MS, going to
+// sleep for ST7789_SLPIN_DELAY_MS. Set the partial area before entering
+// partial mode.
+// Param st7789Mode_t mode: mode to switch to.
+// Return: void
+void ST7789_SetMode(st7789Mode_t mode)
+{
+    bool wake = displayMode == ST7789_MODE_SLEEP;
+
+    if (mode == displayMode)
+        return;
+
+    ST7789_Select();
+
+    if (wake)
+    {
+        ST7789_WriteCommand(ST7789_SLPOUT_ADDR);
+        delay_ms(ST7789_SLPOUT_DELAY_MS);
+    }
+
+    if (mode == ST7789_MODE_SLEEP)
+    {
+        ST7789_WriteCommand(ST7789_SLPIN_ADDR);
+        delay_ms(ST7789_SLPIN_DELAY_MS);
+    }
+    else
+    {
+        // partial and idle mode aren't tracked through sleep, so both are
+        // sent again after waking
+        if (wake || (mode ^ displayMode) & ST7789_MODE_PARTIAL)
+        {
+            ST7789_WriteCommand(mode & ST7789_MODE_PARTIAL ? ST7789_PLTON_ADDR :
+                                                             ST7789_NORON_ADDR);
+        }
+        if (wake || (mode ^ displayMode) & ST7789_MODE_IDLE)
+        {
+            ST7789_WriteCommand(mode & ST7789_MODE_IDLE ? ST7789_IDMON_ADDR :
+                                                          ST7789_IDMOFF_ADDR);
+        }
+    }
+
+    displayMode = mode;
+    ST7789_Deselect();
+}
+
+// ST7789_GetMode
+// Gets the display mode.
+// Return: st7789Mode_t
+st7789Mode_t ST7789_GetMode(void)
+{
+    return displayMode;
+}
+
+// ST7789_SetColorMode
+// Switches the interface pixel format. Colors passed to the draw functions
+// stay RGB565 either way, they are converted as they are sent. Frame
+// memory isn't converted, so whatever is on screen should be redrawn.
+// Param uint8_t mode: ST7789_COLMOD_RGB565 or ST7789_COLMOD_RGB444.
+// Return: void
+void ST7789_SetColorMode(uint8_t mode)
+{
+    ST7789_Select();
+    ST7789_WriteCommand(ST7789_COLMOD_ADDR);
+    ST7789_WriteData(mode);
+    colorMode = mode;
+    ST7789_Deselect();
+}
+
+// ST7789_GetColorMode
+// Gets the interface pixel format.
+// Return: uint8_t, ST7789_COLMOD_RGB565 or ST7789_COLMOD_RGB444
+uint8_t ST7789_GetColorMode(void)
+{
+    return colorMode;
+}
+
+// ST7789_ToRGB444
+// Rounds an RGB565 color to the 12-bit format sent in RGB444 mode. The
+// fields keep their order, so BGR565 colors become BGR444.
+// Param uint16_t color: RGB565 color.
+// Return: uint16_t, 4 bits per field in the low 12 bits
+uint16_t ST7789_ToRGB444(uint16_t color)
+{
+    uint16_t r = ((color >> 11) * 15 + 15) / 31;
+    uint16_t g = (((color >> 5) & 0x3F) * 15 + 31) / 63;
+    uint16_t b = ((color & 0x1F) * 15 + 15) / 31;
+
+    return r << 8 | g << 4 | b;
+}
+
+// ST7789_FromRGB444
+// Widens a 12-bit color back to RGB565, e.g. to see what a color will look
+// like in RGB444 mode.
+// Param uint16_t color: 4 bits per field in the low 12 bits.
+// Return: uint16_t, RGB565 color
+uint16_t ST7789_FromRGB444(uint16_t color)
+{
+    uint16_t r = (color >> 8) & 0xF, g = (color >> 4) & 0xF, b = color & 0xF;
+
+    return (r << 1 | r >> 3) << 11 | (g << 2 | g >> 2) << 5 | (b << 1 | b >> 3);
+}
+
+// ST7789_ConvertPalette
+// Rounds a table of RGB565 colors to what RGB444 mode can show, still as
+// RGB565. Colors that end up equal can't be told apart in RGB444 mode.
+// Param uint16_t* colors: colors to convert, in place.
+// Param uint16_t count: number of colors.
+// Return: void
+void ST7789_ConvertPalette(uint16_t *colors, uint16_t count)
+{
+    while (count--)
+    {
+        *colors = ST7789_FromRGB444(ST7789_ToRGB444(*colors));
+        colors++;
+    }
+}
+
+// ST7789_DrawOutline
+// Draws a one pixel outline of a rectangle, as four windows under one
+// select. The corners are only sent once.
+// Param uint16_t x: x-coord of top left corner.
+// Param uint16_t y: y-coord of top left corner.
+// Param uint16_t w: width of rectangle.
+// Param uint16_t h: height of rectangle.
+// Param uint16_t color: color of outline.
+// Return: void
+void ST7789_DrawOutline(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+    ST7789_Select();
+    Raster_Outline(x, y, w, h, color, ST7789_Span);
+    ST7789_Deselect();
+}
+
+const uint8_t* ST7789_GetCharGlyph(const fontStyle_t *font, char c)
+{
+    // fonts hold every code from FirstAsciiCode on, so this indexes directly
+    uint8_t index = (uint8_t) c - font->FirstAsciiCode;
+
+    if (index >= font->GlyphCount)
+        return NULL;
+
+    // pointer to the last row of the glyph
+    return &(font->GlyphBitmaps[(index + 1) * font->GlyphBytesWidth * font->GlyphHeight
+            - font->GlyphBytesWidth]);
+}
+
+// ST7789_GetGlyphRuns
+// Looks up the pre-expanded runs of a glyph in the generated glyph cache.
+// Return: const uint8_t*, NULL if the glyph isn't cached
+static const uint8_t* ST7789_GetGlyphRuns(const fontStyle_t *font, char c)
+{
+    const glyphCache_t *cache = &GlyphCache_Emulogic;
+    uint8_t index = (uint8_t) c - font->FirstAsciiCode;
+
+    if (font != cache->Font || index >= font->GlyphCount
+            || cache->Index[index] == GLYPHCACHE_NONE)
+        return NULL;
+
+    return &cache->Runs[cache->Offsets[cache->Index[index]]];
+}
+
+// ST7789_GetTextWidth
+// Gets the width in pixels of a string as ST7789_DrawText would draw it.
+// Characters missing from the font take no space.
+// Param fontStyle_t* font: font to measure with.
+// Param char* text: string to measure.
+// Return: uint16_t
+uint16_t ST7789_GetTextWidth(const fontStyle_t *font, const char *text)
+{
+    uint16_t w = 0;
+
+    while (*text)
+    {
+        if (ST7789_GetCharGlyph(font, *text++))
+            w += font->FixedWidth;
+    }
+
+    return w;
+}
+
+// ST7789_DrawText
+// Draws a string with its background. Glyphs are drawn in batches of up to
+// ST7789_TEXT_MAX_GLYPHS under one window, with each row expanded to runs
+// of RGB565 pixels, or taken as runs from the generated glyph cache.
+// Glyphs that would go past the right edge are dropped.
+// Param fontStyle_t* font: font to draw with.
+// Param char* text: string to draw.
+// Param uint16_t x: x-coord of top left corner.
+// Param uint16_t y: y-coord of top left corner.
+// Param uint16_t color: color of glyph pixels.
+// Param uint16_t bgColor: color of the rest of the glyph cells.
+// Return: void
 void ST7789_DrawText(const fontStyle_t *font, const char *text, uint16_t x, uint16_t y,
                      uint16_t color, uint16_t bgColor)
 {
+    const uint8_t *glyphs[ST7789_TEXT_MAX_GLYPHS];
+    const uint8_t *runs[ST7789_TEXT_MAX_GLYPHS];
+
+    if (y + font->GlyphHeight > Y_MAX)
+        return;
+
+    color = ST7789_PixelValue(color);
+    bgColor = ST7789_PixelValue(bgColor);
+
     while (*text)
     {
-        const uint8_t *glyph = ST7789_GetCharGlyph(font, *text);
-        if (glyph)
+        uint8_t n = 0;
+        uint8_t fit = x < X_MAX ? (X_MAX - x) / font->FixedWidth : 0;
+
+        if (fit > ST7789_TEXT_MAX_GLYPHS)
+            fit = ST7789_TEXT_MAX_GLYPHS;
+
+        while (*text && n < fit)
         {
-            for (uint16_t row = 0; row < font->GlyphHeight; row++)
+            const uint8_t *glyph = ST7789_GetCharGlyph(font, *text);
+            if (glyph)
             {
-                uint8_t rowData = *glyph;
+                runs[n] = ST7789_GetGlyphRuns(font, *text);
+                glyphs[n++] = glyph;
+            }
+            text++;
+        }
 
-                for (uint8_t col = 0; col < font->FixedWidth; col++)
+        if (!n)
+            return;
+
+        uint16_t w = n * font->FixedWidth;
+        uint16_t runColor = bgColor;
+        uint32_t run = 0;
+
+        ST7789_Select();
+        ST7789_SetWindow(x, y, w, font->GlyphHeight);
+        ST7789_BeginPixels();
+
+        // glyphs are stored top row first, rows count up from the bottom of the screen
+        for (uint16_t row = 0; row < font->GlyphHeight; row++)
+        {
+            for (uint8_t i = 0; i < n; i++)
+            {
+                // cached rows are runs of background and color, bottom row first
+                if (runs[i])
                 {
-                    if (rowData & (0x80 >> col))
+                    bool fg = false;
+
+                    for (uint8_t left = font->FixedWidth; left; fg = !fg)
                     {
-                        ST7789_DrawPixel(x + col, y + row, color);
+                        uint8_t len = *runs[i]++;
+                        uint16_t c = fg ? color : bgColor;
+
+                        if (!len)
+                            continue;
+
+                        if (c != runColor)
+                        {
+                            ST7789_WriteRepeat(runColor, run);
+                            runColor = c;
+                            run = 0;
+                        }
+                        run += len;
+                        left -= len;
                     }
-                    else
+                    continue;
+                }
+
+                const uint8_t *rowData = glyphs[i] - row * font->GlyphBytesWidth;
+
+                for (uint8_t col = 0; col < font->FixedWidth; col++)
+                {
+                    uint16_t c = (rowData[col >> 3] & (0x80 >> (col & 7))) ? color : bgColor;
+
+                    if (c != runColor)
                     {
-                        ST7789_DrawPixel(x + col, y + row, bgColor);
+                        ST7789_WriteRepeat(runColor, run);
+                        runColor = c;
+                        run = 0;
                     }
+                    run++;
                 }
-                glyph -= font->GlyphBytesWidth;
             }
-            x += font->FixedWidth;
         }
-        text++;
+
+        ST7789_WriteRepeat(runColor, run);
+        ST7789_Deselect();
+
+        x += w;
     }
 }
-
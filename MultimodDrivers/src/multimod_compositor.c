@@ -0,0 +1,232 @@
+// multimod_compositor.c
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-26
+// Composes small screen regions from rects. Built with DISPLAYLIST_HOST
+// defined Compositor_Submit is left out, for tools/st7789emu.
+
+/************************************Includes***************************************/
+
+#include "../multimod_compositor.h"
+
+#include <string.h>
+
+#include "../multimod_ST7789.h"
+#include "../../G8RTOS/G8RTOS_Semaphores.h"
+
+#ifndef DISPLAYLIST_HOST
+#include "../multimod_displaylist.h"
+#endif
+
+/************************************Includes***************************************/
+
+/****************************Data Structure Definitions*****************************/
+
+// Window being drawn by Compositor_Draw, starting at row first
+typedef struct compositorDraw_t
+{
+    const compositor_t *c;
+    uint16_t first;
+} compositorDraw_t;
+
+/****************************Data Structure Definitions*****************************/
+
+/*******************************Private Variables***********************************/
+
+// held by the render thread while it draws from drawn, and by a commit
+// while it replaces drawn
+static semaphore_t sem_Compositor = 1;
+
+/*******************************Private Variables***********************************/
+
+/********************************Private Functions**********************************/
+
+// Compositor_Line
+// Paints one row of a composition: background, then every rect crossing
+// the row in order.
+// Param uint16_t* "line": c->w pixels
+static void Compositor_Line(const compositor_t *c, const compositorRect_t *rects, uint8_t count,
+                            uint16_t row, uint16_t *line)
+{
+    for (uint16_t i = 0; i < c->w; i++)
+        line[i] = c->background;
+
+    for (uint8_t r = 0; r < count; r++)
+    {
+        const compositorRect_t *rect = &rects[r];
+
+        if (row < rect->y || row >= rect->y + rect->h)
+            continue;
+
+        for (uint16_t i = rect->x; i < rect->x + rect->w; i++)
+            line[i] = rect->color;
+    }
+}
+
+// Compositor_Source
+// Line source for ST7789_DrawLines, from what was last submitted.
+static void Compositor_Source(const void *context, uint16_t row, uint16_t *line)
+{
+    const compositorDraw_t *draw = context;
+
+    Compositor_Line(draw->c, draw->c->drawn, draw->c->drawnCount, draw->first + row, line);
+}
+
+/********************************Private Functions**********************************/
+
+/********************************Public Functions***********************************/
+
+// Compositor_Init
+// Sets up an empty composition of a region. Nothing is drawn until the
+// first submit, which sends the whole region.
+// Param compositor_t* "c": compositor to set up
+// Param uint16_t "x": x-coord of top left corner
+// Param uint16_t "y": y-coord of top left corner
+// Param uint16_t "w": width, at most ST7789_LINE_MAX_PIXELS
+// Param uint16_t "h": height, at most 255
+// Param uint16_t "background": color under the rects
+// Return: void
+void Compositor_Init(compositor_t *c, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                     uint16_t background)
+{
+    memset(c, 0, sizeof(*c));
+    c->x = x;
+    c->y = y;
+    c->w = w > ST7789_LINE_MAX_PIXELS ? ST7789_LINE_MAX_PIXELS : w;
+    c->h = h > UINT8_MAX ? UINT8_MAX : h;
+    c->background = background;
+}
+
+// Compositor_Clear
+// Starts a new composition, only the background is left.
+// Param compositor_t* "c": compositor
+// Return: void
+void Compositor_Clear(compositor_t *c)
+{
+    c->count = 0;
+}
+
+// Compositor_Rect
+// Adds a filled rect on top of what is composed so far. Parts outside of
+// the region are cut off.
+// Param compositor_t* "c": compositor
+// Param uint16_t "x": x-coord of top left corner, on the screen
+// Param uint16_t "y": y-coord of top left corner, on the screen
+// Param uint16_t "w": width
+// Param uint16_t "h": height
+// Param uint16_t "color": color of rect
+// Return: void
+void Compositor_Rect(compositor_t *c, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                     uint16_t color)
+{
+    int32_t x0 = (int32_t) x - c->x, y0 = (int32_t) y - c->y;
+    int32_t x1 = x0 + w, y1 = y0 + h;
+    compositorRect_t *rect;
+
+    if (x0 < 0)
+        x0 = 0;
+    if (y0 < 0)
+        y0 = 0;
+    if (x1 > c->w)
+        x1 = c->w;
+    if (y1 > c->h)
+        y1 = c->h;
+
+    if (x0 >= x1 || y0 >= y1 || c->count == COMPOSITOR_MAX_RECTS)
+        return;
+
+    rect = &c->rects[c->count++];
+    rect->x = x0;
+    rect->y = y0;
+    rect->w = x1 - x0;
+    rect->h = y1 - y0;
+    rect->color = color;
+}
+
+// Compositor_Invalidate
+// Makes the next submit send the whole region, e.g. after the screen was
+// cleared.
+// Param compositor_t* "c": compositor
+// Return: void
+void Compositor_Invalidate(compositor_t *c)
+{
+    c->drawnValid = false;
+}
+
+// Compositor_Commit
+// Compares the composition with the last one line by line and makes it
+// the one drawn from. Waits for a draw of any composition in progress
+// before replacing what it draws from.
+// Param compositor_t* "c": compositor
+// Param uint16_t* "y": first screen row that changed
+// Param uint16_t* "h": number of rows from y to the last one that changed
+// Return: bool, false if nothing changed
+bool Compositor_Commit(compositor_t *c, uint16_t *y, uint16_t *h)
+{
+    uint16_t now[ST7789_LINE_MAX_PIXELS], was[ST7789_LINE_MAX_PIXELS];
+    int16_t first = -1, last = -1;
+
+    for (uint16_t row = 0; row < c->h; row++)
+    {
+        if (c->drawnValid)
+        {
+            Compositor_Line(c, c->rects, c->count, row, now);
+            Compositor_Line(c, c->drawn, c->drawnCount, row, was);
+
+            if (!memcmp(now, was, c->w * sizeof(uint16_t)))
+                continue;
+        }
+
+        if (first < 0)
+            first = row;
+        last = row;
+    }
+
+    G8RTOS_WaitSemaphore(&sem_Compositor);
+    memcpy(c->drawn, c->rects, c->count * sizeof(compositorRect_t));
+    c->drawnCount = c->count;
+    G8RTOS_SignalSemaphore(&sem_Compositor);
+    c->drawnValid = true;
+
+    if (first < 0)
+        return false;
+
+    *y = c->y + first;
+    *h = last - first + 1;
+    return true;
+}
+
+#ifndef DISPLAYLIST_HOST
+// Compositor_Submit
+// Records the rows that changed since the last submit as one op of the
+// recording display list.
+// Param compositor_t* "c": compositor
+// Return: void
+void Compositor_Submit(compositor_t *c)
+{
+    uint16_t y, h;
+
+    if (Compositor_Commit(c, &y, &h))
+        DisplayList_Composite(c, y, h);
+}
+#endif
+
+// Compositor_Draw
+// Draws rows of the last committed composition in one window. Commits
+// wait until it is done, so every row comes from the same one.
+// Param compositor_t* "c": compositor
+// Param uint16_t "y": first screen row to draw
+// Param uint16_t "h": number of rows
+// Return: void
+void Compositor_Draw(const compositor_t *c, uint16_t y, uint16_t h)
+{
+    compositorDraw_t draw = { c, y - c->y };
+
+    if (y < c->y || y + h > c->y + c->h)
+        return;
+
+    G8RTOS_WaitSemaphore(&sem_Compositor);
+    ST7789_DrawLines(c->x, y, c->w, h, Compositor_Source, &draw);
+    G8RTOS_SignalSemaphore(&sem_Compositor);
+}
+
+/********************************Public Functions***********************************/
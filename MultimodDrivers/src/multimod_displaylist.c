@@ -0,0 +1,564 @@
+// multimod_displaylist.c
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-26
+// Display list for the ST7789. Built with DISPLAYLIST_HOST defined only
+// DisplayList_Optimize and DisplayList_Prioritize are compiled, for
+// tools/dlreplay.
+
+/************************************Includes***************************************/
+
+#include "../multimod_displaylist.h"
+
+#include <string.h>
+
+#ifndef DISPLAYLIST_HOST
+#include <driverlib/uartstdio.h>
+
+#include "../multimod_ST7789.h"
+#include "../multimod_framepacer.h"
+#include "../../G8RTOS/G8RTOS_Semaphores.h"
+#include "../../G8RTOS/G8RTOS_Scheduler.h"
+#endif
+
+/************************************Includes***************************************/
+
+/*******************************Private Variables***********************************/
+
+#ifndef DISPLAYLIST_HOST
+static displayOp_t lists[2][DISPLAYLIST_MAX_OPS];
+static uint16_t counts[2];
+static uint8_t recordList = 0;
+
+// threads waiting for the recording list to be swapped out
+static uint8_t swapWaiting = 0;
+static bool trace = false;
+
+// lane of each thread that called DisplayList_SetLane, others use
+// DISPLAYLIST_LANE_BOARD
+static tcb_t *laneThreads[MAX_THREADS];
+static uint8_t laneOf[MAX_THREADS];
+
+static semaphore_t sem_DisplayList = 1;
+static semaphore_t sem_DisplayListPending = 0;
+static semaphore_t sem_DisplayListSwapped = 0;
+#endif
+
+/*******************************Private Variables***********************************/
+
+/********************************Private Functions**********************************/
+
+// DisplayList_Overlaps
+// Checks if two ops draw to any of the same pixels.
+// Return: bool
+static bool DisplayList_Overlaps(const displayOp_t *a, const displayOp_t *b)
+{
+    return a->x < b->x + b->w && b->x < a->x + a->w && a->y < b->y + b->h
+            && b->y < a->y + a->h;
+}
+
+// DisplayList_Covers
+// Checks if the area of op a contains the area of op b.
+// Return: bool
+static bool DisplayList_Covers(const displayOp_t *a, const displayOp_t *b)
+{
+    return a->x <= b->x && a->y <= b->y && a->x + a->w >= b->x + b->w
+            && a->y + a->h >= b->y + b->h;
+}
+
+// DisplayList_Opaque
+// Checks if an op paints every pixel of its area.
+// Return: bool
+static bool DisplayList_Opaque(const displayOp_t *op)
+{
+    return op->type == DISPLAYLIST_RECT || op->type == DISPLAYLIST_TEXT
+            || op->type == DISPLAYLIST_BLIT || op->type == DISPLAYLIST_COMPOSITE
+            || op->type == DISPLAYLIST_PATTERN;
+}
+
+// DisplayList_Merge
+// Grows rect a to also cover rect b, if they are the same color and
+// together form a rectangle.
+// Return: bool, true if b is now part of a
+static bool DisplayList_Merge(displayOp_t *a, const displayOp_t *b)
+{
+    uint16_t start, end;
+
+    if (a->type != DISPLAYLIST_RECT || b->type != DISPLAYLIST_RECT || a->color != b->color)
+        return false;
+
+    if (DisplayList_Covers(a, b))
+        return true;
+
+    if (DisplayList_Covers(b, a))
+    {
+        *a = *b;
+        return true;
+    }
+
+    // same columns, touching or overlapping rows
+    if (a->x == b->x && a->w == b->w && b->y <= a->y + a->h && a->y <= b->y + b->h)
+    {
+        start = a->y < b->y ? a->y : b->y;
+        end = a->y + a->h > b->y + b->h ? a->y + a->h : b->y + b->h;
+        a->y = start;
+        a->h = end - start;
+        return true;
+    }
+
+    // same rows, touching or overlapping columns
+    if (a->y == b->y && a->h == b->h && b->x <= a->x + a->w && a->x <= b->x + b->w)
+    {
+        start = a->x < b->x ? a->x : b->x;
+        end = a->x + a->w > b->x + b->w ? a->x + a->w : b->x + b->w;
+        a->x = start;
+        a->w = end - start;
+        return true;
+    }
+
+    return false;
+}
+
+#ifndef DISPLAYLIST_HOST
+// DisplayList_Lane
+// Looks up the lane of the calling thread.
+// Return: uint8_t
+static uint8_t DisplayList_Lane(void)
+{
+    for (uint8_t i = 0; i < MAX_THREADS; i++)
+    {
+        if (laneThreads[i] == CurrentlyRunningThread)
+            return laneOf[i];
+    }
+
+    return DISPLAYLIST_LANE_BOARD;
+}
+
+// DisplayList_Append
+// Copies an op into the recording list, tagged with the caller's lane. If
+// the lane's share of the list is full it is handed to the render thread
+// and the caller blocks until it has been swapped.
+// Return: void
+static void DisplayList_Append(const displayOp_t *op)
+{
+    uint8_t lane = DisplayList_Lane();
+    uint16_t limit = DISPLAYLIST_MAX_OPS - lane * DISPLAYLIST_LANE_RESERVE;
+
+    G8RTOS_WaitSemaphore(&sem_DisplayList);
+
+    while (counts[recordList] >= limit)
+    {
+        swapWaiting++;
+        G8RTOS_SignalSemaphore(&sem_DisplayList);
+        G8RTOS_SignalSemaphore(&sem_DisplayListPending);
+        G8RTOS_WaitSemaphore(&sem_DisplayListSwapped);
+        G8RTOS_WaitSemaphore(&sem_DisplayList);
+    }
+
+    lists[recordList][counts[recordList]] = *op;
+    lists[recordList][counts[recordList]++].lane = lane;
+
+    G8RTOS_SignalSemaphore(&sem_DisplayList);
+}
+
+// DisplayList_Print
+// Prints a list over UART in the format tools/dlreplay reads. The lane
+// follows the op letter, so replays are prioritized like the board.
+// Return: void
+static void DisplayList_Print(const displayOp_t *ops, uint16_t count)
+{
+    UARTprintf("L %u\n", count);
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        const displayOp_t *op = &ops[i];
+
+        switch (op->type)
+        {
+        case DISPLAYLIST_RECT:
+            UARTprintf("R%u %u %u %u %u %x\n", op->lane, op->x, op->y, op->w, op->h, op->color);
+            break;
+        case DISPLAYLIST_OUTLINE:
+            UARTprintf("O%u %u %u %u %u %x\n", op->lane, op->x, op->y, op->w, op->h, op->color);
+            break;
+        case DISPLAYLIST_TEXT:
+            UARTprintf("T%u %u %u %u %u %x %x %s\n", op->lane, op->x, op->y, op->w, op->h,
+                       op->color, op->bgColor, op->data.text);
+            break;
+        case DISPLAYLIST_BLIT:
+            UARTprintf("B%u %u %u %u %u\n", op->lane, op->x, op->y, op->w, op->h);
+            break;
+        case DISPLAYLIST_SCROLL:
+            UARTprintf("S%u %u %u %u\n", op->lane, op->data.scroll.top, op->data.scroll.height,
+                       op->data.scroll.start);
+            break;
+        case DISPLAYLIST_COMPOSITE:
+            UARTprintf("C%u %u %u %u %u\n", op->lane, op->x, op->y, op->w, op->h);
+            break;
+        case DISPLAYLIST_MODE:
+            UARTprintf("M%u %u %u %u\n", op->lane, op->data.mode.mode, op->data.mode.top,
+                       op->data.mode.height);
+            break;
+        case DISPLAYLIST_PATTERN:
+            UARTprintf("P%u %u %u %u %u\n", op->lane, op->x, op->y, op->w, op->h);
+            break;
+        }
+    }
+}
+
+// DisplayList_Execute
+// Draws a single op.
+// Return: void
+static void DisplayList_Execute(const displayOp_t *op)
+{
+    switch (op->type)
+    {
+    case DISPLAYLIST_RECT:
+        ST7789_DrawRectangle(op->x, op->y, op->w, op->h, op->color);
+        break;
+    case DISPLAYLIST_OUTLINE:
+        ST7789_DrawOutline(op->x, op->y, op->w, op->h, op->color);
+        break;
+    case DISPLAYLIST_TEXT:
+        ST7789_DrawText(op->font, op->data.text, op->x, op->y, op->color, op->bgColor);
+        break;
+    case DISPLAYLIST_BLIT:
+        ST7789_DrawBitmap(op->x, op->y, op->w, op->h, op->data.bitmap);
+        break;
+    case DISPLAYLIST_SCROLL:
+        ST7789_SetScrollArea(op->data.scroll.top, op->data.scroll.height);
+        ST7789_SetScrollStart(op->data.scroll.start);
+        break;
+    case DISPLAYLIST_COMPOSITE:
+        Compositor_Draw(op->data.composite, op->y, op->h);
+        break;
+    case DISPLAYLIST_MODE:
+        if (op->data.mode.mode & ST7789_MODE_PARTIAL)
+            ST7789_SetPartialArea(op->data.mode.top, op->data.mode.height);
+        ST7789_SetMode((st7789Mode_t) op->data.mode.mode);
+        break;
+    case DISPLAYLIST_PATTERN:
+        ST7789_FillPattern(op->x, op->y, op->w, op->h, op->data.pattern);
+        break;
+    }
+}
+#endif
+
+/********************************Private Functions**********************************/
+
+/********************************Public Functions***********************************/
+
+// DisplayList_Optimize
+// Removes draws that a later opaque op paints over completely, then folds
+// same color rects into earlier ones when the union is still a rect. A
+// rect is only moved earlier past ops it doesn't overlap, so the drawn
+// result is the same as drawing the list in order.
+// Param displayOp_t* "ops": list to optimize in place
+// Param uint16_t "count": number of ops in the list
+// Return: uint16_t, number of ops left
+uint16_t DisplayList_Optimize(displayOp_t *ops, uint16_t count)
+{
+    uint16_t i, j, n = 0;
+
+    for (j = 1; j < count; j++)
+    {
+        if (!DisplayList_Opaque(&ops[j]))
+            continue;
+
+        for (i = 0; i < j; i++)
+        {
+            if (ops[i].type != DISPLAYLIST_NOP && ops[i].type != DISPLAYLIST_SCROLL
+                    && ops[i].type != DISPLAYLIST_MODE && DisplayList_Covers(&ops[j], &ops[i]))
+                ops[i].type = DISPLAYLIST_NOP;
+        }
+    }
+
+    for (j = 1; j < count; j++)
+    {
+        if (ops[j].type != DISPLAYLIST_RECT)
+            continue;
+
+        for (i = j; i-- > 0;)
+        {
+            if (ops[i].type == DISPLAYLIST_NOP)
+                continue;
+
+            if (DisplayList_Merge(&ops[i], &ops[j]))
+            {
+                ops[j].type = DISPLAYLIST_NOP;
+                break;
+            }
+
+            if (DisplayList_Overlaps(&ops[i], &ops[j]))
+                break;
+        }
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        if (ops[i].type != DISPLAYLIST_NOP)
+            ops[n++] = ops[i];
+    }
+
+    return n;
+}
+
+// DisplayList_Prioritize
+// Moves ops of earlier lanes ahead of ops of later lanes, keeping the
+// recorded order within a lane. An op is only moved past ops it doesn't
+// overlap, so the drawn result is the same as drawing the list in order.
+// Param displayOp_t* "ops": list to reorder in place
+// Param uint16_t "count": number of ops in the list
+// Return: void
+void DisplayList_Prioritize(displayOp_t *ops, uint16_t count)
+{
+    displayOp_t op;
+    uint16_t i, j;
+
+    for (j = 1; j < count; j++)
+    {
+        op = ops[j];
+
+        for (i = j; i > 0 && ops[i - 1].lane > op.lane; i--)
+        {
+            if (DisplayList_Overlaps(&ops[i - 1], &op))
+                break;
+        }
+
+        if (i == j)
+            continue;
+
+        memmove(&ops[i + 1], &ops[i], (j - i) * sizeof(displayOp_t));
+        ops[i] = op;
+    }
+}
+
+#ifndef DISPLAYLIST_HOST
+// DisplayList_Rect
+// Records a filled rectangle.
+// Param uint16_t x: x-coord of first point.
+// Param uint16_t y: y-coord of first point.
+// Param uint16_t w: width of rectangle
+// Param uint16_t h: height of retangle.
+// Param uint16_t color: color of rectangle.
+// Return: void
+void DisplayList_Rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+    displayOp_t op = { DISPLAYLIST_RECT, x, y, w, h, color };
+
+    if (w && h)
+        DisplayList_Append(&op);
+}
+
+// DisplayList_Outline
+// Records a one pixel outline of a rectangle.
+// Param uint16_t x: x-coord of first point.
+// Param uint16_t y: y-coord of first point.
+// Param uint16_t w: width of rectangle
+// Param uint16_t h: height of retangle.
+// Param uint16_t color: color of outline.
+// Return: void
+void DisplayList_Outline(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+    displayOp_t op = { DISPLAYLIST_OUTLINE, x, y, w, h, color };
+
+    if (w && h)
+        DisplayList_Append(&op);
+}
+
+// DisplayList_Text
+// Records a string, truncated to DISPLAYLIST_TEXT_LEN - 1 characters.
+// Param fontStyle_t* font: font to draw with.
+// Param char* text: string to draw, copied.
+// Param uint16_t x: x-coord of top left corner.
+// Param uint16_t y: y-coord of top left corner.
+// Param uint16_t color: color of glyph pixels.
+// Param uint16_t bgColor: color of the rest of the glyph cells.
+// Return: void
+void DisplayList_Text(const fontStyle_t *font, const char *text, uint16_t x, uint16_t y,
+                      uint16_t color, uint16_t bgColor)
+{
+    displayOp_t op = { DISPLAYLIST_TEXT, x, y, 0, font->GlyphHeight, color, bgColor, font };
+
+    strncpy(op.data.text, text, DISPLAYLIST_TEXT_LEN - 1);
+    op.data.text[DISPLAYLIST_TEXT_LEN - 1] = '\0';
+    op.w = ST7789_GetTextWidth(font, op.data.text);
+
+    if (op.w)
+        DisplayList_Append(&op);
+}
+
+// DisplayList_Blit
+// Records a bitmap. The data is not copied.
+// Param uint16_t x: x-coord of first point.
+// Param uint16_t y: y-coord of first point.
+// Param uint16_t w: width of bitmap.
+// Param uint16_t h: height of bitmap.
+// Param uint8_t* data: w * h RGB565 pixels, high byte first.
+// Return: void
+void DisplayList_Blit(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint8_t *data)
+{
+    displayOp_t op = { DISPLAYLIST_BLIT, x, y, w, h };
+
+    op.data.bitmap = data;
+
+    if (w && h)
+        DisplayList_Append(&op);
+}
+
+// DisplayList_Scroll
+// Records a change of the vertical scroll band and offset. Ops before it
+// are drawn before the display scrolls, ops after it after.
+// Param uint16_t top: first line of the band.
+// Param uint16_t height: number of lines in the band.
+// Param uint16_t start: frame memory line shown first in the band.
+// Return: void
+void DisplayList_Scroll(uint16_t top, uint16_t height, uint16_t start)
+{
+    displayOp_t op = { DISPLAYLIST_SCROLL, 0, 0, X_MAX, Y_MAX };
+
+    op.data.scroll.top = top;
+    op.data.scroll.height = height;
+    op.data.scroll.start = start;
+
+    DisplayList_Append(&op);
+}
+
+// DisplayList_Composite
+// Records rows of a composition, drawn from whatever it last committed.
+// Use Compositor_Submit rather than calling this directly.
+// Param compositor_t* c: composition, not copied.
+// Param uint16_t y: first row to draw.
+// Param uint16_t h: number of rows.
+// Return: void
+void DisplayList_Composite(const compositor_t *c, uint16_t y, uint16_t h)
+{
+    displayOp_t op = { DISPLAYLIST_COMPOSITE, c->x, y, c->w, h };
+
+    op.data.composite = c;
+
+    if (h)
+        DisplayList_Append(&op);
+}
+
+// DisplayList_Pattern
+// Records a window filled with a repeated tile. The tile is not copied.
+// Param uint16_t x: x-coord of first point.
+// Param uint16_t y: y-coord of first point.
+// Param uint16_t w: width of window.
+// Param uint16_t h: height of window.
+// Param st7789Pattern_t* pattern: tile, its first pixel lands on x, y.
+// Return: void
+void DisplayList_Pattern(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                         const st7789Pattern_t *pattern)
+{
+    displayOp_t op = { DISPLAYLIST_PATTERN, x, y, w, h };
+
+    op.data.pattern = pattern;
+
+    if (w && h)
+        DisplayList_Append(&op);
+}
+
+// DisplayList_Mode
+// Records a change of the display mode. Ops before it are drawn in the old
+// mode, ops after it in the new one.
+// Param uint8_t mode: an st7789Mode_t.
+// Param uint16_t top: first line refreshed in partial mode.
+// Param uint16_t height: number of lines refreshed in partial mode.
+// Return: void
+void DisplayList_Mode(uint8_t mode, uint16_t top, uint16_t height)
+{
+    displayOp_t op = { DISPLAYLIST_MODE, 0, 0, X_MAX, Y_MAX };
+
+    op.data.mode.mode = mode;
+    op.data.mode.top = top;
+    op.data.mode.height = height;
+
+    DisplayList_Append(&op);
+}
+
+// DisplayList_SetLane
+// Sets the lane of every op the calling thread records from now on.
+// Param displayLane_t "lane": lane, DISPLAYLIST_LANE_PIECE is drawn first
+// Return: void
+void DisplayList_SetLane(displayLane_t lane)
+{
+    uint8_t i;
+
+    G8RTOS_WaitSemaphore(&sem_DisplayList);
+
+    for (i = 0; i < MAX_THREADS - 1; i++)
+    {
+        if (laneThreads[i] == CurrentlyRunningThread || !laneThreads[i])
+            break;
+    }
+    laneThreads[i] = CurrentlyRunningThread;
+    laneOf[i] = lane < DISPLAYLIST_LANES ? lane : DISPLAYLIST_LANE_UI;
+
+    G8RTOS_SignalSemaphore(&sem_DisplayList);
+}
+
+// DisplayList_Submit
+// Marks the end of a batch of ops, waking the render thread.
+// Return: void
+void DisplayList_Submit(void)
+{
+    G8RTOS_SignalSemaphore(&sem_DisplayListPending);
+}
+
+// DisplayList_Render
+// Body of the render thread. Waits for a submit, swaps the recording list
+// out, then optimizes it, orders it by lane and draws it as one display
+// batch. With the frame pacer enabled drawing starts at the next vsync.
+// Return: void
+void DisplayList_Render(void)
+{
+    uint8_t list;
+    uint16_t count;
+
+    G8RTOS_WaitSemaphore(&sem_DisplayListPending);
+
+    G8RTOS_WaitSemaphore(&sem_DisplayList);
+    list = recordList;
+    count = counts[list];
+    recordList ^= 1;
+    counts[recordList] = 0;
+    while (swapWaiting)
+    {
+        swapWaiting--;
+        G8RTOS_SignalSemaphore(&sem_DisplayListSwapped);
+    }
+    G8RTOS_SignalSemaphore(&sem_DisplayList);
+
+    if (!count)
+        return;
+
+    if (trace)
+        DisplayList_Print(lists[list], count);
+
+    count = DisplayList_Optimize(lists[list], count);
+    DisplayList_Prioritize(lists[list], count);
+
+    FramePacer_WaitVsync();
+
+    // the whole list is sent under one CS assertion
+    ST7789_BeginBatch();
+    for (uint16_t i = 0; i < count; i++)
+        DisplayList_Execute(&lists[list][i]);
+    ST7789_EndBatch();
+
+    FramePacer_EndFrame();
+}
+
+// DisplayList_SetTrace
+// Enables printing every list over UART before it is optimized, to be
+// replayed with tools/dlreplay.
+// Param bool "enable": print lists
+// Return: void
+void DisplayList_SetTrace(bool enable)
+{
+    trace = enable;
+}
+#endif
+
+/********************************Public Functions***********************************/
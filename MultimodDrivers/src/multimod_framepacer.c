@@ -0,0 +1,275 @@
+// multimod_framepacer.c
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-26
+// Frame pacing off the ST7789 TE line. Built with FRAMEPACER_HOST defined
+// only the stats functions are compiled, for tools/fpsim.
+
+/************************************Includes***************************************/
+
+#include "../multimod_framepacer.h"
+
+#ifndef FRAMEPACER_HOST
+#include <inc/hw_memmap.h>
+#include <inc/hw_ints.h>
+
+#include <driverlib/gpio.h>
+#include <driverlib/sysctl.h>
+#include <driverlib/uartstdio.h>
+
+#include "../multimod_ST7789.h"
+#include "../../G8RTOS/G8RTOS_Clock.h"
+#include "../../G8RTOS/G8RTOS_CriticalSection.h"
+#include "../../G8RTOS/G8RTOS_Scheduler.h"
+#include "../../G8RTOS/G8RTOS_Semaphores.h"
+#include "../../G8RTOS/G8RTOS_Timers.h"
+#endif
+
+/************************************Includes***************************************/
+
+/*******************************Private Variables***********************************/
+
+#ifndef FRAMEPACER_HOST
+static framePacerStats_t collected;
+static bool enabled = false;
+
+// set while the render thread waits, so vsyncs nobody waits for don't pile
+// up in the semaphore
+static volatile bool waiting = false;
+static uint64_t flushStart;
+
+static timerID_t timeoutTimer;
+static semaphore_t sem_Vsync = 0;
+static semaphore_t sem_VsyncTimeout = 0;
+#endif
+
+/*******************************Private Variables***********************************/
+
+/********************************Private Functions**********************************/
+
+#ifndef FRAMEPACER_HOST
+// FramePacer_Timeout
+// Timer callback, releases a flush when no vsync came.
+// Return: void
+static void FramePacer_Timeout(void)
+{
+    G8RTOS_SignalSemaphore(&sem_VsyncTimeout);
+}
+#endif
+
+/********************************Private Functions**********************************/
+
+/********************************Public Functions***********************************/
+
+// FramePacer_ResetStats
+// Clears collected frame timing.
+// Param framePacerStats_t* "stats": stats to clear
+// Return: void
+void FramePacer_ResetStats(framePacerStats_t *stats)
+{
+    *stats = (framePacerStats_t) { 0 };
+    stats->periodMin = UINT32_MAX;
+    stats->latencyMin = UINT32_MAX;
+    stats->intervalMin = UINT32_MAX;
+}
+
+// FramePacer_RecordVsync
+// Records the start of a panel refresh.
+// Param framePacerStats_t* "stats": stats to update
+// Param uint64_t "ns": time of the TE edge
+// Return: void
+void FramePacer_RecordVsync(framePacerStats_t *stats, uint64_t ns)
+{
+    if (stats->vsyncs)
+    {
+        uint32_t period = (uint32_t) (ns - stats->lastVsync);
+
+        if (period < stats->periodMin)
+            stats->periodMin = period;
+        if (period > stats->periodMax)
+            stats->periodMax = period;
+        stats->periodSum += period;
+    }
+
+    stats->vsyncs++;
+    stats->lastVsync = ns;
+}
+
+// FramePacer_RecordFlush
+// Records a display list being drawn. Late flushes were still drawing when
+// the refresh after their vsync started, at the average period.
+// Param framePacerStats_t* "stats": stats to update
+// Param uint64_t "start": time drawing started
+// Param uint64_t "end": time drawing finished
+// Return: void
+void FramePacer_RecordFlush(framePacerStats_t *stats, uint64_t start, uint64_t end)
+{
+    uint32_t duration = (uint32_t) (end - start);
+
+    if (stats->vsyncs)
+    {
+        uint32_t latency = (uint32_t) (start - stats->lastVsync);
+
+        if (latency < stats->latencyMin)
+            stats->latencyMin = latency;
+        if (latency > stats->latencyMax)
+            stats->latencyMax = latency;
+        stats->latencySum += latency;
+
+        if (stats->vsyncs > 1
+                && end > stats->lastVsync + stats->periodSum / (stats->vsyncs - 1))
+            stats->late++;
+    }
+
+    if (stats->flushes)
+    {
+        uint32_t interval = (uint32_t) (start - stats->lastFlush);
+
+        if (interval < stats->intervalMin)
+            stats->intervalMin = interval;
+        if (interval > stats->intervalMax)
+            stats->intervalMax = interval;
+        stats->intervalSum += interval;
+    }
+
+    if (duration > stats->durationMax)
+        stats->durationMax = duration;
+
+    stats->flushes++;
+    stats->lastFlush = start;
+}
+
+// FramePacer_Jitter
+// Spread of the time from vsync to flush start.
+// Param framePacerStats_t* "stats": collected stats
+// Return: uint32_t, ns
+uint32_t FramePacer_Jitter(const framePacerStats_t *stats)
+{
+    if (stats->latencyMax < stats->latencyMin)
+        return 0;
+
+    return stats->latencyMax - stats->latencyMin;
+}
+
+#ifndef FRAMEPACER_HOST
+// FramePacer_Init
+// Turns on the ST7789 TE output (vblank only) and its edge interrupt, and
+// enables pacing of DisplayList_Render.
+// Return: void
+void FramePacer_Init(void)
+{
+    FramePacer_ResetStats(&collected);
+
+    SysCtlPeripheralEnable(FRAMEPACER_TE_GPIO_PERIPH);
+    while (!SysCtlPeripheralReady(FRAMEPACER_TE_GPIO_PERIPH))
+        ;
+
+    GPIOPinTypeGPIOInput(FRAMEPACER_TE_GPIO_BASE, FRAMEPACER_TE_PIN);
+    GPIOIntTypeSet(FRAMEPACER_TE_GPIO_BASE, FRAMEPACER_TE_PIN, GPIO_RISING_EDGE);
+    GPIOIntClear(FRAMEPACER_TE_GPIO_BASE, FRAMEPACER_TE_PIN);
+    GPIOIntEnable(FRAMEPACER_TE_GPIO_BASE, FRAMEPACER_TE_PIN);
+
+    timeoutTimer = G8RTOS_CreateTimer(FramePacer_Timeout, FRAMEPACER_TIMEOUT_MS, TIMER_ONE_SHOT);
+    G8RTOS_AddAperiodicEvent(FramePacer_Handler, FRAMEPACER_PRIORITY, FRAMEPACER_TE_INT);
+
+    ST7789_SetTearingEffect(true);
+
+    enabled = true;
+}
+
+// FramePacer_WaitVsync
+// Blocks until the next vsync, or FRAMEPACER_TIMEOUT_MS. Returns right away
+// if pacing isn't enabled.
+// Return: void
+void FramePacer_WaitVsync(void)
+{
+    semaphore_t *set[] = { &sem_Vsync, &sem_VsyncTimeout };
+
+    if (enabled)
+    {
+        G8RTOS_InitSemaphore(&sem_Vsync, 0);
+        G8RTOS_InitSemaphore(&sem_VsyncTimeout, 0);
+        waiting = true;
+        G8RTOS_StartTimer(timeoutTimer);
+
+        if (G8RTOS_WaitAny(set, 2) == 1)
+            collected.timeouts++;
+
+        waiting = false;
+        G8RTOS_StopTimer(timeoutTimer);
+    }
+
+    flushStart = G8RTOS_GetTimeNs();
+}
+
+// FramePacer_EndFrame
+// Records the flush started by the last FramePacer_WaitVsync. The TE
+// handler updates the same stats, so it is held off meanwhile.
+// Return: void
+void FramePacer_EndFrame(void)
+{
+    int32_t BasePri_State;
+
+    if (!enabled)
+        return;
+
+    BasePri_State = StartKernelCriticalSection();
+    FramePacer_RecordFlush(&collected, flushStart, G8RTOS_GetTimeNs());
+    EndKernelCriticalSection(BasePri_State);
+}
+
+// FramePacer_Report
+// Prints frame timing over UART and starts collecting again.
+// Return: void
+void FramePacer_Report(void)
+{
+    framePacerStats_t stats;
+    uint32_t periods, intervals;
+    int32_t BasePri_State;
+
+    if (!enabled)
+        return;
+
+    BasePri_State = StartKernelCriticalSection();
+    stats = collected;
+    FramePacer_ResetStats(&collected);
+    EndKernelCriticalSection(BasePri_State);
+
+    periods = stats.vsyncs > 1 ? stats.vsyncs - 1 : 1;
+    intervals = stats.flushes > 1 ? stats.flushes - 1 : 1;
+
+    if (!stats.flushes)
+    {
+        UARTprintf("Frames: none\n");
+        return;
+    }
+
+    UARTprintf("Vsync: %u, period %u us (%u-%u)\n", stats.vsyncs,
+               (uint32_t) (stats.periodSum / periods / 1000), stats.periodMin / 1000,
+               stats.periodMax / 1000);
+    UARTprintf("Frames: %u, interval %u us (%u-%u), longest %u us, %u late, %u timed out\n",
+               stats.flushes, (uint32_t) (stats.intervalSum / intervals / 1000),
+               stats.intervalMin / 1000, stats.intervalMax / 1000, stats.durationMax / 1000,
+               stats.late, stats.timeouts);
+    UARTprintf("Vsync to flush: %u us, jitter %u us\n",
+               (uint32_t) (stats.latencySum / stats.flushes / 1000),
+               FramePacer_Jitter(&stats) / 1000);
+}
+
+// FramePacer_Handler
+// TE rising edge, the panel is entering vblank.
+// Return: void
+void FramePacer_Handler(void)
+{
+    GPIOIntClear(FRAMEPACER_TE_GPIO_BASE, FRAMEPACER_TE_PIN);
+
+    FramePacer_RecordVsync(&collected, G8RTOS_GetTimeNs());
+
+    if (waiting)
+    {
+        waiting = false;
+        G8RTOS_SignalSemaphore(&sem_Vsync);
+    }
+}
+#endif
+
+/********************************Public Functions***********************************/
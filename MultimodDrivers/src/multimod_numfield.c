@@ -0,0 +1,131 @@
+// multimod_numfield.c
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-26
+// Right aligned number fields drawn through the display list.
+
+/************************************Includes***************************************/
+
+#include "../multimod_numfield.h"
+
+#include <string.h>
+
+#include "../multimod_displaylist.h"
+
+/************************************Includes***************************************/
+
+/********************************Public Functions***********************************/
+
+// NumField_Init
+// Sets up a field ending at right. The cells are laid out here once, the
+// first update draws all of them.
+// Param numField_t* "f": field to set up
+// Param fontStyle_t* "font": fixed width font to draw with
+// Param uint16_t "right": x-coord one past the last cell
+// Param uint16_t "y": y-coord of the cells
+// Param uint8_t "digits": number of cells, at most NUMFIELD_MAX_DIGITS
+// Param uint16_t "color": color of the digits
+// Param uint16_t "bgColor": color of the rest of the cells
+// Return: void
+void NumField_Init(numField_t *f, const fontStyle_t *font, uint16_t right, uint16_t y,
+                   uint8_t digits, uint16_t color, uint16_t bgColor)
+{
+    if (digits > NUMFIELD_MAX_DIGITS)
+        digits = NUMFIELD_MAX_DIGITS;
+
+    f->font = font;
+    f->x = right - digits * font->FixedWidth;
+    f->y = y;
+    f->color = color;
+    f->bgColor = bgColor;
+    f->digits = digits;
+    NumField_Invalidate(f);
+}
+
+// NumField_Invalidate
+// Makes the next update draw every cell, e.g. after the screen was cleared.
+// Param numField_t* "f": field
+// Return: void
+void NumField_Invalidate(numField_t *f)
+{
+    memset(f->drawn, 0, sizeof(f->drawn));
+}
+
+// NumField_Format
+// Writes a number right aligned into digits characters, padded with
+// spaces and not terminated. Numbers that don't fit are shown as all 9s.
+// One divide per digit, no sprintf.
+// Param uint32_t "value": number to write
+// Param char* "out": digits characters
+// Param uint8_t "digits": width
+// Return: uint8_t, number of digits written
+uint8_t NumField_Format(uint32_t value, char *out, uint8_t digits)
+{
+    uint8_t i = digits, n;
+
+    if (!digits)
+        return 0;
+
+    do
+    {
+        uint32_t q = value / 10;
+
+        out[--i] = '0' + (value - q * 10);
+        value = q;
+    } while (value && i);
+
+    if (value)
+    {
+        memset(out, '9', digits);
+        return digits;
+    }
+
+    n = digits - i;
+    memset(out, ' ', i);
+    return n;
+}
+
+// NumField_Set
+// Records the cells that differ from what the field shows now, one text op
+// per run of changed cells.
+// Param numField_t* "f": field
+// Param uint32_t "value": number to show
+// Return: bool, true if anything was recorded
+bool NumField_Set(numField_t *f, uint32_t value)
+{
+    char now[NUMFIELD_MAX_DIGITS + 1] = { 0 }, next;
+    uint8_t i = 0, start;
+    bool changed = false;
+
+    if (!f->digits)
+        return false;
+
+    NumField_Format(value, now, f->digits);
+
+    while (i < f->digits)
+    {
+        if (now[i] == f->drawn[i])
+        {
+            i++;
+            continue;
+        }
+
+        start = i;
+        while (i < f->digits && now[i] != f->drawn[i])
+        {
+            f->drawn[i] = now[i];
+            i++;
+        }
+
+        // end the run in place for the text op, keeping the next cell
+        next = now[i];
+        now[i] = '\0';
+        DisplayList_Text(f->font, &now[start], f->x + start * f->font->FixedWidth, f->y,
+                         f->color, f->bgColor);
+        now[i] = next;
+        changed = true;
+    }
+
+    return changed;
+}
+
+/********************************Public Functions***********************************/
@@ -0,0 +1,119 @@
+// multimod_raster.c
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-26
+// Line and outline rasterizing as runs of pixels
+
+/************************************Includes***************************************/
+
+#include "../multimod_raster.h"
+
+#include <stdlib.h>
+
+/************************************Includes***************************************/
+
+/***********************************Macro Defines***********************************/
+#ifndef _swap_int16_t
+#define _swap_int16_t(a, b) \
+{  \
+    int16_t t = a; \
+    a = b; \
+    b = t; \
+}
+#endif
+
+/********************************Public Functions***********************************/
+
+// Raster_Line
+// Bresenham line from point 1 to point 2. Pixels that share a row (or a
+// column, for steep lines) are passed on as one run, the pixels covered
+// are the same as plotting the line point by point.
+// Param uint16_t x0: x-coord of first point.
+// Param uint16_t y0: y-coord of first point.
+// Param uint16_t x1: x-coord of second point.
+// Param uint16_t y1: y-coord of second point.
+// Param uint16_t color: color of line.
+// Param rasterSpan_t span: called for every run.
+// Return: void
+void Raster_Line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color,
+                 rasterSpan_t span)
+{
+    bool steep = abs((int16_t) (y1 - y0)) > abs((int16_t) (x1 - x0));
+    if (steep)
+    {
+        _swap_int16_t(x0, y0);
+        _swap_int16_t(x1, y1);
+    }
+
+    if (x0 > x1)
+    {
+        _swap_int16_t(x0, x1);
+        _swap_int16_t(y0, y1);
+    }
+
+    int16_t dx, dy;
+    dx = x1 - x0;
+    dy = abs((int16_t) (y1 - y0));
+
+    int16_t err = dx / 2;
+    int16_t ystep = y0 < y1 ? 1 : -1;
+    uint16_t start = x0;
+
+    for (; x0 <= x1; x0++)
+    {
+        err -= dy;
+
+        // the run ends where the line steps to the next row, or at the end
+        if (err < 0 || x0 == x1)
+        {
+            if (steep)
+            {
+                span(y0, start, 1, x0 - start + 1, color);
+            }
+            else
+            {
+                span(start, y0, x0 - start + 1, 1, color);
+            }
+
+            start = x0 + 1;
+        }
+
+        if (err < 0)
+        {
+            y0 += ystep;
+            err += dx;
+        }
+    }
+}
+
+// Raster_Outline
+// One pixel outline of a rectangle as up to four runs that don't overlap.
+// Top and bottom come first, then left and right, so neighbouring runs
+// share their columns or rows.
+// Param uint16_t x: x-coord of top left corner.
+// Param uint16_t y: y-coord of top left corner.
+// Param uint16_t w: width of rectangle.
+// Param uint16_t h: height of rectangle.
+// Param uint16_t color: color of outline.
+// Param rasterSpan_t span: called for every run.
+// Return: void
+void Raster_Outline(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color,
+                    rasterSpan_t span)
+{
+    if (!w || !h)
+        return;
+
+    span(x, y, w, 1, color);
+
+    if (h > 1)
+        span(x, y + h - 1, w, 1, color);
+
+    if (h > 2)
+    {
+        span(x, y + 1, 1, h - 2, color);
+
+        if (w > 1)
+            span(x + w - 1, y + 1, 1, h - 2, color);
+    }
+}
+
+/********************************Public Functions***********************************/
@@ -10,10 +10,102 @@
 #include <driverlib/gpio.h>
 #include <driverlib/sysctl.h>
 #include <driverlib/pin_map.h>
+#include <driverlib/cpu.h>
 
 #include <inc/tm4c123gh6pm.h>
+#include <inc/hw_types.h>
 #include <inc/hw_ssi.h>
 
+#include "../../G8RTOS/G8RTOS_Scheduler.h"
+#include "../../G8RTOS/G8RTOS_Semaphores.h"
+
+/*******************************Private Variables***********************************/
+
+// uDMA channel control table, needs to be 1024 byte aligned
+#pragma DATA_ALIGN(dmaControlTable, 1024)
+static uint8_t dmaControlTable[1024];
+
+// Source of repeated transfers, sent as one 16-bit frame per item
+static uint16_t dmaValue;
+
+static const uint8_t *dmaSource;
+static bool dmaRepeat;
+static volatile uint32_t dmaRemaining = 0;
+static volatile bool dmaHalfBusy[2];
+static volatile bool dmaDone = true;
+
+static semaphore_t sem_SPI_DMA = 0;
+
+/*******************************Private Variables***********************************/
+
+/********************************Private Functions**********************************/
+
+// SPI_DMA_Arm
+// Loads the next chunk of the transfer into one half of the ping-pong pair.
+// Param uint32_t "half": UDMA_PRI_SELECT or UDMA_ALT_SELECT
+// Return: void
+static void SPI_DMA_Arm(uint32_t half)
+{
+    uint32_t n = dmaRemaining < SPI_DMA_MAX_ITEMS ? dmaRemaining : SPI_DMA_MAX_ITEMS;
+    const void *src = dmaRepeat ? (const void*) &dmaValue : (const void*) dmaSource;
+
+    if (!dmaRepeat)
+        dmaSource += n;
+
+    dmaRemaining -= n;
+    dmaHalfBusy[half == UDMA_ALT_SELECT] = true;
+
+    uDMAChannelTransferSet(SPI_A_DMA_CHANNEL | half, UDMA_MODE_PINGPONG, (void*) src,
+                           (void*) (SPI_A_BASE + SSI_O_DR), n);
+}
+
+// SPI_DMA_Start
+// Arms both halves and starts the channel from the primary structure.
+// Repeats read one halfword over and over, buffers are walked bytewise.
+// Return: void
+static void SPI_DMA_Start(void)
+{
+    uint32_t control = dmaRepeat ?
+            (UDMA_SIZE_16 | UDMA_SRC_INC_NONE | UDMA_DST_INC_NONE | UDMA_ARB_4) :
+            (UDMA_SIZE_8 | UDMA_SRC_INC_8 | UDMA_DST_INC_NONE | UDMA_ARB_4);
+
+    dmaDone = false;
+
+    uDMAChannelAttributeDisable(SPI_A_DMA_CHANNEL, UDMA_ATTR_ALTSELECT);
+    uDMAChannelControlSet(SPI_A_DMA_CHANNEL | UDMA_PRI_SELECT, control);
+    uDMAChannelControlSet(SPI_A_DMA_CHANNEL | UDMA_ALT_SELECT, control);
+
+    SPI_DMA_Arm(UDMA_PRI_SELECT);
+    if (dmaRemaining)
+        SPI_DMA_Arm(UDMA_ALT_SELECT);
+
+    uDMAChannelEnable(SPI_A_DMA_CHANNEL);
+}
+
+// SPI_DMA_Wait
+// Blocks until the running transfer has fully left the shift register.
+// Other threads run in the meantime. With interrupts off (e.g. before
+// G8RTOS_Launch) the done interrupt can't fire, so the handler is polled.
+// Return: void
+static void SPI_DMA_Wait(uint32_t mod)
+{
+    if (CPUprimask())
+    {
+        while (!dmaDone)
+            SPI_DMA_Handler();
+
+        G8RTOS_InitSemaphore(&sem_SPI_DMA, 0);
+    }
+    else
+    {
+        G8RTOS_WaitSemaphore(&sem_SPI_DMA);
+    }
+
+    SPI_WaitIdle(mod);
+}
+
+/********************************Private Functions**********************************/
+
 /********************************Public Functions***********************************/
 
 // SPI_Init
@@ -39,8 +131,10 @@ void SPI_Init(uint32_t mod)
         SSIDisable(mod);
         SSIClockSourceSet(mod, SSI_CLOCK_SYSTEM);
         SSIConfigSetExpClk(SSI0_BASE, SysCtlClockGet(), SSI_FRF_MOTO_MODE_3, SSI_MODE_MASTER,
-                           15000000, 8);
+                           SPI_A_CLOCK_HZ, 8);
         SSIEnable(mod);
+
+        SPI_DMA_Init(mod);
     }
 }
 
@@ -124,3 +218,296 @@ void SPI_ReadMultiple(uint32_t mod, uint32_t *data, uint8_t num_bytes)
 
     return;
 }
+
+// SPI_WaitIdle
+// Waits until the TX FIFO is empty and the last frame has been shifted
+// out. Needed before DC or CS change, as the streaming writes below
+// return as soon as their data is queued.
+// Param uint32_t "mod": base address of module
+// Return: void
+void SPI_WaitIdle(uint32_t mod)
+{
+    while (SSIBusy(mod))
+        ;
+}
+
+// SPI_SetClock
+// Changes the bit rate of a module to the fastest it can divide the system
+// clock to without going over hz. SSIClk = SysClk / (CPSDVSR * (1 + SCR)),
+// with CPSDVSR even. Rates are compared rounded down like the one returned,
+// so passing a returned rate back sets the same divider. Waits for the bus
+// to go idle first.
+// Param uint32_t "mod": base address of module
+// Param uint32_t "hz": bit rate wanted
+// Return: uint32_t, bit rate set
+uint32_t SPI_SetClock(uint32_t mod, uint32_t hz)
+{
+    uint32_t sysClock = SysCtlClockGet();
+    uint32_t prescale, divide = 256;
+
+    if (!hz)
+        hz = 1;
+    if (hz > sysClock)
+        hz = sysClock;
+
+    for (prescale = 2; prescale < 254; prescale += 2)
+    {
+        divide = sysClock / (prescale * (hz + 1)) + 1;
+        if (divide <= 256)
+            break;
+    }
+
+    if (!divide)
+        divide = 1;
+    if (divide > 256)
+        divide = 256;
+
+    if ((HWREG(mod + SSI_O_CPSR) & SSI_CPSR_CPSDVSR_M) != prescale
+            || ((HWREG(mod + SSI_O_CR0) & SSI_CR0_SCR_M) >> SSI_CR0_SCR_S) != divide - 1)
+    {
+        SPI_WaitIdle(mod);
+
+        // clock can only be changed with the module disabled
+        SSIDisable(mod);
+        HWREG(mod + SSI_O_CPSR) = prescale;
+        HWREG(mod + SSI_O_CR0) = (HWREG(mod + SSI_O_CR0) & ~SSI_CR0_SCR_M)
+                | ((divide - 1) << SSI_CR0_SCR_S);
+        SSIEnable(mod);
+    }
+
+    return sysClock / (prescale * divide);
+}
+
+// SPI_GetClock
+// Gets the bit rate a module is set to.
+// Param uint32_t "mod": base address of module
+// Return: uint32_t, Hz
+uint32_t SPI_GetClock(uint32_t mod)
+{
+    uint32_t prescale = HWREG(mod + SSI_O_CPSR) & SSI_CPSR_CPSDVSR_M;
+    uint32_t divide = ((HWREG(mod + SSI_O_CR0) & SSI_CR0_SCR_M) >> SSI_CR0_SCR_S) + 1;
+
+    return prescale ? SysCtlClockGet() / (prescale * divide) : 0;
+}
+
+// SPI_WriteStream
+// Writes multiple bytes, one frame each, only stalling while the TX FIFO
+// is full so the bus never idles between frames. Returns with data still
+// in flight, call SPI_WaitIdle before touching DC or CS.
+// Param uint32_t "mod": base address of module
+// Param uint8_t* "data": pointer to an array of bytes
+// Param uint32_t "num_bytes": number of bytes to transmit
+// Return: void
+void SPI_WriteStream(uint32_t mod, const uint8_t *data, uint32_t num_bytes)
+{
+    while (num_bytes--)
+        SSIDataPut(mod, *data++);
+}
+
+// SPI_ReadStream
+// Reads bytes from the selected device, clocking out zeros. Frames left in
+// the RX FIFO by earlier writes are thrown away first.
+// Param uint32_t "mod": base address of module
+// Param uint8_t* "data": buffer for num_bytes bytes
+// Param uint32_t "num_bytes": number of bytes to read
+// Return: void
+void SPI_ReadStream(uint32_t mod, uint8_t *data, uint32_t num_bytes)
+{
+    uint32_t value;
+
+    SPI_WaitIdle(mod);
+    while (SSIDataGetNonBlocking(mod, &value))
+        ;
+
+    while (num_bytes--)
+    {
+        SSIDataPut(mod, 0x00);
+        SSIDataGet(mod, &value);
+        *data++ = value;
+    }
+}
+
+// SPI_WriteRepeat16
+// Writes the same 16-bit value (MSB first) count times through the
+// TX FIFO. Returns with data still in flight like SPI_WriteStream.
+// With frames wider than 8 bits this is one FIFO write per value instead
+// of two, and only the low frame size bits of value are sent.
+// Param uint32_t "mod": base address of module
+// Param uint16_t "value": value to repeat
+// Param uint32_t "count": number of times to send value
+// Return: void
+void SPI_WriteRepeat16(uint32_t mod, uint16_t value, uint32_t count)
+{
+    if (SPI_GetFrameSize(mod) > 8)
+    {
+        while (count--)
+            SSIDataPut(mod, value);
+        return;
+    }
+
+    uint8_t hi = value >> 8, lo = value & 0xFF;
+
+    while (count--)
+    {
+        SSIDataPut(mod, hi);
+        SSIDataPut(mod, lo);
+    }
+}
+
+// SPI_GetFrameSize
+// Gets the number of bits per frame the module is set to.
+// Param uint32_t "mod": base address of module
+// Return: uint8_t
+uint8_t SPI_GetFrameSize(uint32_t mod)
+{
+    return (HWREG(mod + SSI_O_CR0) & SSI_CR0_DSS_M) + 1;
+}
+
+// SPI_SetFrameSize
+// Changes the number of bits per frame, e.g. 16 for pixel data and 8 for
+// commands. Waits for the bus to go idle, as queued frames are shifted out
+// with whatever size is set when they leave the FIFO.
+// Param uint32_t "mod": base address of module
+// Param uint8_t "bits": 4 to 16 bits per frame
+// Return: void
+void SPI_SetFrameSize(uint32_t mod, uint8_t bits)
+{
+    if (SPI_GetFrameSize(mod) == bits)
+        return;
+
+    SPI_WaitIdle(mod);
+
+    // frame format can only be changed with the module disabled
+    SSIDisable(mod);
+    HWREG(mod + SSI_O_CR0) = (HWREG(mod + SSI_O_CR0) & ~SSI_CR0_DSS_M) | (bits - 1);
+    SSIEnable(mod);
+}
+
+// SPI_DMA_Init
+// Sets up the uDMA TX channel of a module for background transfers.
+// Param uint32_t "mod": base address of module
+// Return: void
+void SPI_DMA_Init(uint32_t mod)
+{
+    if (mod != SPI_A_BASE)
+        return;
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UDMA);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_UDMA))
+        ;
+
+    uDMAEnable();
+    uDMAControlBaseSet(dmaControlTable);
+
+    uDMAChannelAssign(UDMA_CH11_SSI0TX);
+    uDMAChannelAttributeDisable(SPI_A_DMA_CHANNEL,
+                                UDMA_ATTR_ALTSELECT | UDMA_ATTR_HIGH_PRIORITY | UDMA_ATTR_REQMASK);
+
+    // control words are set per transfer, refill whenever the TX FIFO is half empty
+    SSIDMAEnable(mod, SSI_DMA_TX);
+
+    // uDMA completion is signalled on the SSI vector
+    G8RTOS_AddAperiodicEvent(SPI_DMA_Handler, SPI_DMA_PRIORITY, INT_SSI0);
+}
+
+// SPI_DMA_Handler
+// uDMA done interrupt. Refills whichever half of the ping-pong pair finished,
+// and releases the waiting thread once the whole transfer is out.
+// Return: void
+void SPI_DMA_Handler(void)
+{
+    uDMAIntClear(1 << SPI_A_DMA_CHANNEL);
+
+    if (dmaDone)
+        return;
+
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        uint32_t half = i ? UDMA_ALT_SELECT : UDMA_PRI_SELECT;
+
+        if (dmaHalfBusy[i] && uDMAChannelModeGet(SPI_A_DMA_CHANNEL | half) == UDMA_MODE_STOP)
+        {
+            dmaHalfBusy[i] = false;
+
+            if (dmaRemaining && uDMAChannelIsEnabled(SPI_A_DMA_CHANNEL))
+                SPI_DMA_Arm(half);
+        }
+    }
+
+    if (!dmaHalfBusy[0] && !dmaHalfBusy[1])
+    {
+        if (dmaRemaining)
+        {
+            // both halves ran dry before we got here and the channel stopped
+            SPI_DMA_Start();
+        }
+        else
+        {
+            dmaDone = true;
+            G8RTOS_SignalSemaphore(&sem_SPI_DMA);
+        }
+    }
+}
+
+// SPI_WriteDMA
+// Writes a buffer using the uDMA. The calling thread blocks until the
+// transfer is done, so the chip can be deselected right after.
+// Param uint32_t "mod": base address of module
+// Param uint8_t* "data": pointer to an array of bytes
+// Param uint32_t "num_bytes": number of bytes to transmit
+// Return: void
+void SPI_WriteDMA(uint32_t mod, const uint8_t *data, uint32_t num_bytes)
+{
+    if (!num_bytes)
+        return;
+
+    if (mod != SPI_A_BASE)
+    {
+        SPI_WriteStream(mod, data, num_bytes);
+        SPI_WaitIdle(mod);
+        return;
+    }
+
+    dmaSource = data;
+    dmaRepeat = false;
+    dmaRemaining = num_bytes;
+
+    SPI_DMA_Start();
+    SPI_DMA_Wait(mod);
+}
+
+// SPI_WriteRepeatDMA
+// Writes the same 16-bit value (MSB first) count times using the uDMA,
+// e.g. for solid color fills. Blocks like SPI_WriteDMA. The uDMA repeats a
+// single item, so 8-bit frames are switched to 16 for the transfer and
+// restored after. Wider frames are kept, sending the low frame size bits
+// of value like SPI_WriteRepeat16.
+// Param uint32_t "mod": base address of module
+// Param uint16_t "value": value to repeat
+// Param uint32_t "count": number of times to send value
+// Return: void
+void SPI_WriteRepeatDMA(uint32_t mod, uint16_t value, uint32_t count)
+{
+    if (!count)
+        return;
+
+    if (mod != SPI_A_BASE)
+    {
+        SPI_WriteRepeat16(mod, value, count);
+        SPI_WaitIdle(mod);
+        return;
+    }
+
+    uint8_t frameSize = SPI_GetFrameSize(mod);
+    if (frameSize == 8)
+        SPI_SetFrameSize(mod, 16);
+
+    dmaValue = value;
+    dmaRepeat = true;
+    dmaRemaining = count;
+
+    SPI_DMA_Start();
+    SPI_DMA_Wait(mod);
+
+    SPI_SetFrameSize(mod, frameSize);
+}
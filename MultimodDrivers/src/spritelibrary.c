@@ -0,0 +1,224 @@
+//
+// Sprite C source generated by sprite2c.py
+//
+
+#include <stdint.h>
+#include "../spritelibrary.h"
+
+// block.png, 10x10, indexed_rle, 47 bytes (200 raw)
+static uint16_t const Block_Palette[4] = {
+        0xF79E, 0x528A, 0x94B2, 0x7BCF,
+};
+
+static uint8_t const Block_Data[39] = {
+        0x00, 0x81, 0x00, 0x72, 0x01, 0x00, 0x72, 0x01, 0x00, 0x12, 0x33, 0x12,
+        0x01, 0x00, 0x12, 0x03, 0x12, 0x03, 0x12, 0x01, 0x00, 0x12, 0x03, 0x12,
+        0x03, 0x12, 0x01, 0x00, 0x12, 0x33, 0x12, 0x01, 0x00, 0x72, 0x01, 0x00,
+        0x72, 0x01, 0x90,
+};
+
+const sprite_t Sprite_Block = { 10, // Width
+        10, // Height
+        SPRITE_INDEXED_RLE, // Format
+        4, // Palette size
+        Block_Palette, Block_Data, 39 };
+
+// logo.png, 144x24, rle565, 2280 bytes (6912 raw)
+static uint8_t const Logo_Data[2280] = {
+        0xFF, 0x00, 0x00, 0x29, 0x00, 0x00, 0x00, 0x7B, 0xDF, 0x02, 0x10, 0x8F,
+        0x0B, 0x00, 0x00, 0x00, 0x6F, 0x3F, 0x02, 0x0A, 0x70, 0x00, 0x6F, 0x3F,
+        0x02, 0x0A, 0x70, 0x00, 0x6F, 0x3F, 0x02, 0x0A, 0x70, 0x00, 0x6F, 0x3F,
+        0x02, 0x0A, 0x70, 0x00, 0x6F, 0x3F, 0x02, 0x0A, 0x70, 0x0B, 0x00, 0x00,
+        0x00, 0x6F, 0xFF, 0x02, 0x0B, 0x8F, 0x0B, 0x00, 0x00, 0x00, 0x97, 0xF0,
+        0x02, 0x23, 0x42, 0x0B, 0x00, 0x00, 0x00, 0x97, 0xF0, 0x02, 0x23, 0x42,
+        0x03, 0x00, 0x00, 0x00, 0xFF, 0xEF, 0x02, 0x7B, 0x42, 0x00, 0xFF, 0xEF,
+        0x02, 0x7B, 0x42, 0x00, 0xFF, 0xEF, 0x02, 0x7B, 0x42, 0x00, 0xFF, 0xEF,
+        0x02, 0x7B, 0x42, 0x00, 0xFF, 0xEF, 0x02, 0x7B, 0x42, 0x03, 0x00, 0x00,
+        0x00, 0xFC, 0xBE, 0x02, 0x69, 0x0A, 0x00, 0xFC, 0xBE, 0x02, 0x69, 0x0A,
+        0x00, 0xFC, 0xBE, 0x02, 0x69, 0x0A, 0x00, 0xFC, 0xBE, 0x02, 0x69, 0x0A,
+        0x0F, 0x00, 0x00, 0x00, 0x7B, 0xDF, 0x01, 0x18, 0xFB, 0x00, 0x10, 0x8F,
+        0x0B, 0x00, 0x00, 0x00, 0x6F, 0x3F, 0x01, 0x14, 0x7E, 0x00, 0x0A, 0x70,
+        0x00, 0x6F, 0x3F, 0x01, 0x14, 0x7E, 0x00, 0x0A, 0x70, 0x00, 0x6F, 0x3F,
+        0x01, 0x14, 0x7E, 0x00, 0x0A, 0x70, 0x00, 0x6F, 0x3F, 0x01, 0x14, 0x7E,
+        0x00, 0x0A, 0x70, 0x00, 0x6F, 0x3F, 0x01, 0x14, 0x7E, 0x00, 0x0A, 0x70,
+        0x0B, 0x00, 0x00, 0x00, 0x6F, 0xFF, 0x01, 0x16, 0x9C, 0x00, 0x0B, 0x8F,
+        0x0B, 0x00, 0x00, 0x00, 0x97, 0xF0, 0x01, 0x3D, 0xE5, 0x00, 0x23, 0x42,
+        0x0B, 0x00, 0x00, 0x00, 0x97, 0xF0, 0x01, 0x3D, 0xE5, 0x00, 0x23, 0x42,
+        0x03, 0x00, 0x00, 0x00, 0xFF, 0xEF, 0x01, 0xDD, 0xE3, 0x00, 0x7B, 0x42,
+        0x00, 0xFF, 0xEF, 0x01, 0xDD, 0xE3, 0x00, 0x7B, 0x42, 0x00, 0xFF, 0xEF,
+        0x01, 0xDD, 0xE3, 0x00, 0x7B, 0x42, 0x00, 0xFF, 0xEF, 0x01, 0xDD, 0xE3,
+        0x00, 0x7B, 0x42, 0x00, 0xFF, 0xEF, 0x01, 0xDD, 0xE3, 0x00, 0x7B, 0x42,
+        0x03, 0x00, 0x00, 0x00, 0xFC, 0xBE, 0x01, 0xC9, 0xF2, 0x00, 0x69, 0x0A,
+        0x00, 0xFC, 0xBE, 0x01, 0xC9, 0xF2, 0x00, 0x69, 0x0A, 0x00, 0xFC, 0xBE,
+        0x01, 0xC9, 0xF2, 0x00, 0x69, 0x0A, 0x00, 0xFC, 0xBE, 0x01, 0xC9, 0xF2,
+        0x00, 0x69, 0x0A, 0x0F, 0x00, 0x00, 0x00, 0x7B, 0xDF, 0x01, 0x18, 0xFB,
+        0x00, 0x10, 0x8F, 0x0B, 0x00, 0x00, 0x00, 0x6F, 0x3F, 0x01, 0x14, 0x7E,
+        0x00, 0x0A, 0x70, 0x00, 0x6F, 0x3F, 0x01, 0x14, 0x7E, 0x00, 0x0A, 0x70,
+        0x00, 0x6F, 0x3F, 0x01, 0x14, 0x7E, 0x00, 0x0A, 0x70, 0x00, 0x6F, 0x3F,
+        0x01, 0x14, 0x7E, 0x00, 0x0A, 0x70, 0x00, 0x6F, 0x3F, 0x01, 0x14, 0x7E,
+        0x00, 0x0A, 0x70, 0x0B, 0x00, 0x00, 0x00, 0x6F, 0xFF, 0x01, 0x16, 0x9C,
+        0x00, 0x0B, 0x8F, 0x0B, 0x00, 0x00, 0x00, 0x97, 0xF0, 0x01, 0x3D, 0xE5,
+        0x00, 0x23, 0x42, 0x0B, 0x00, 0x00, 0x00, 0x97, 0xF0, 0x01, 0x3D, 0xE5,
+        0x00, 0x23, 0x42, 0x03, 0x00, 0x00, 0x00, 0xFF, 0xEF, 0x01, 0xDD, 0xE3,
+        0x00, 0x7B, 0x42, 0x00, 0xFF, 0xEF, 0x01, 0xDD, 0xE3, 0x00, 0x7B, 0x42,
+        0x00, 0xFF, 0xEF, 0x01, 0xDD, 0xE3, 0x00, 0x7B, 0x42, 0x00, 0xFF, 0xEF,
+        0x01, 0xDD, 0xE3, 0x00, 0x7B, 0x42, 0x00, 0xFF, 0xEF, 0x01, 0xDD, 0xE3,
+        0x00, 0x7B, 0x42, 0x03, 0x00, 0x00, 0x00, 0xFC, 0xBE, 0x01, 0xC9, 0xF2,
+        0x00, 0x69, 0x0A, 0x00, 0xFC, 0xBE, 0x01, 0xC9, 0xF2, 0x00, 0x69, 0x0A,
+        0x00, 0xFC, 0xBE, 0x01, 0xC9, 0xF2, 0x00, 0x69, 0x0A, 0x00, 0xFC, 0xBE,
+        0x01, 0xC9, 0xF2, 0x00, 0x69, 0x0A, 0x0F, 0x00, 0x00, 0x03, 0x7B, 0xDF,
+        0x0B, 0x00, 0x00, 0x13, 0x6F, 0x3F, 0x0B, 0x00, 0x00, 0x03, 0x6F, 0xFF,
+        0x0B, 0x00, 0x00, 0x03, 0x97, 0xF0, 0x0B, 0x00, 0x00, 0x03, 0x97, 0xF0,
+        0x03, 0x00, 0x00, 0x13, 0xFF, 0xEF, 0x03, 0x00, 0x00, 0x0F, 0xFC, 0xBE,
+        0x0F, 0x00, 0x00, 0x00, 0x7B, 0xDF, 0x02, 0x10, 0x8F, 0x0B, 0x00, 0x00,
+        0x00, 0x6F, 0x3F, 0x02, 0x0A, 0x70, 0x1B, 0x00, 0x00, 0x00, 0x6F, 0xFF,
+        0x02, 0x0B, 0x8F, 0x0B, 0x00, 0x00, 0x00, 0x97, 0xF0, 0x02, 0x23, 0x42,
+        0x07, 0x00, 0x00, 0x00, 0x97, 0xF0, 0x02, 0x23, 0x42, 0x0F, 0x00, 0x00,
+        0x00, 0xFF, 0xEF, 0x02, 0x7B, 0x42, 0x1B, 0x00, 0x00, 0x00, 0xFC, 0xBE,
+        0x02, 0x69, 0x0A, 0x0B, 0x00, 0x00, 0x00, 0x7B, 0xDF, 0x01, 0x18, 0xFB,
+        0x00, 0x10, 0x8F, 0x0B, 0x00, 0x00, 0x00, 0x6F, 0x3F, 0x01, 0x14, 0x7E,
+        0x00, 0x0A, 0x70, 0x1B, 0x00, 0x00, 0x00, 0x6F, 0xFF, 0x01, 0x16, 0x9C,
+        0x00, 0x0B, 0x8F, 0x0B, 0x00, 0x00, 0x00, 0x97, 0xF0, 0x01, 0x3D, 0xE5,
+        0x00, 0x23, 0x42, 0x07, 0x00, 0x00, 0x00, 0x97, 0xF0, 0x01, 0x3D, 0xE5,
+        0x00, 0x23, 0x42, 0x0F, 0x00, 0x00, 0x00, 0xFF, 0xEF, 0x01, 0xDD, 0xE3,
+        0x00, 0x7B, 0x42, 0x1B, 0x00, 0x00, 0x00, 0xFC, 0xBE, 0x01, 0xC9, 0xF2,
+        0x00, 0x69, 0x0A, 0x0B, 0x00, 0x00, 0x00, 0x7B, 0xDF, 0x01, 0x18, 0xFB,
+        0x00, 0x10, 0x8F, 0x0B, 0x00, 0x00, 0x00, 0x6F, 0x3F, 0x01, 0x14, 0x7E,
+        0x00, 0x0A, 0x70, 0x1B, 0x00, 0x00, 0x00, 0x6F, 0xFF, 0x01, 0x16, 0x9C,
+        0x00, 0x0B, 0x8F, 0x0B, 0x00, 0x00, 0x00, 0x97, 0xF0, 0x01, 0x3D, 0xE5,
+        0x00, 0x23, 0x42, 0x07, 0x00, 0x00, 0x00, 0x97, 0xF0, 0x01, 0x3D, 0xE5,
+        0x00, 0x23, 0x42, 0x0F, 0x00, 0x00, 0x00, 0xFF, 0xEF, 0x01, 0xDD, 0xE3,
+        0x00, 0x7B, 0x42, 0x1B, 0x00, 0x00, 0x00, 0xFC, 0xBE, 0x01, 0xC9, 0xF2,
+        0x00, 0x69, 0x0A, 0x0B, 0x00, 0x00, 0x03, 0x7B, 0xDF, 0x0B, 0x00, 0x00,
+        0x03, 0x6F, 0x3F, 0x1B, 0x00, 0x00, 0x03, 0x6F, 0xFF, 0x0B, 0x00, 0x00,
+        0x03, 0x97, 0xF0, 0x07, 0x00, 0x00, 0x03, 0x97, 0xF0, 0x0F, 0x00, 0x00,
+        0x03, 0xFF, 0xEF, 0x1B, 0x00, 0x00, 0x03, 0xFC, 0xBE, 0x0B, 0x00, 0x00,
+        0x00, 0x7B, 0xDF, 0x02, 0x10, 0x8F, 0x0B, 0x00, 0x00, 0x00, 0x6F, 0x3F,
+        0x02, 0x0A, 0x70, 0x00, 0x6F, 0x3F, 0x02, 0x0A, 0x70, 0x00, 0x6F, 0x3F,
+        0x02, 0x0A, 0x70, 0x00, 0x6F, 0x3F, 0x02, 0x0A, 0x70, 0x0F, 0x00, 0x00,
+        0x00, 0x6F, 0xFF, 0x02, 0x0B, 0x8F, 0x0B, 0x00, 0x00, 0x00, 0x97, 0xF0,
+        0x02, 0x23, 0x42, 0x00, 0x97, 0xF0, 0x02, 0x23, 0x42, 0x00, 0x97, 0xF0,
+        0x02, 0x23, 0x42, 0x00, 0x97, 0xF0, 0x02, 0x23, 0x42, 0x0F, 0x00, 0x00,
+        0x00, 0xFF, 0xEF, 0x02, 0x7B, 0x42, 0x0F, 0x00, 0x00, 0x00, 0xFC, 0xBE,
+        0x02, 0x69, 0x0A, 0x00, 0xFC, 0xBE, 0x02, 0x69, 0x0A, 0x00, 0xFC, 0xBE,
+        0x02, 0x69, 0x0A, 0x0F, 0x00, 0x00, 0x00, 0x7B, 0xDF, 0x01, 0x18, 0xFB,
+        0x00, 0x10, 0x8F, 0x0B, 0x00, 0x00, 0x00, 0x6F, 0x3F, 0x01, 0x14, 0x7E,
+        0x00, 0x0A, 0x70, 0x00, 0x6F, 0x3F, 0x01, 0x14, 0x7E, 0x00, 0x0A, 0x70,
+        0x00, 0x6F, 0x3F, 0x01, 0x14, 0x7E, 0x00, 0x0A, 0x70, 0x00, 0x6F, 0x3F,
+        0x01, 0x14, 0x7E, 0x00, 0x0A, 0x70, 0x0F, 0x00, 0x00, 0x00, 0x6F, 0xFF,
+        0x01, 0x16, 0x9C, 0x00, 0x0B, 0x8F, 0x0B, 0x00, 0x00, 0x00, 0x97, 0xF0,
+        0x01, 0x3D, 0xE5, 0x00, 0x23, 0x42, 0x00, 0x97, 0xF0, 0x01, 0x3D, 0xE5,
+        0x00, 0x23, 0x42, 0x00, 0x97, 0xF0, 0x01, 0x3D, 0xE5, 0x00, 0x23, 0x42,
+        0x00, 0x97, 0xF0, 0x01, 0x3D, 0xE5, 0x00, 0x23, 0x42, 0x0F, 0x00, 0x00,
+        0x00, 0xFF, 0xEF, 0x01, 0xDD, 0xE3, 0x00, 0x7B, 0x42, 0x0F, 0x00, 0x00,
+        0x00, 0xFC, 0xBE, 0x01, 0xC9, 0xF2, 0x00, 0x69, 0x0A, 0x00, 0xFC, 0xBE,
+        0x01, 0xC9, 0xF2, 0x00, 0x69, 0x0A, 0x00, 0xFC, 0xBE, 0x01, 0xC9, 0xF2,
+        0x00, 0x69, 0x0A, 0x0F, 0x00, 0x00, 0x00, 0x7B, 0xDF, 0x01, 0x18, 0xFB,
+        0x00, 0x10, 0x8F, 0x0B, 0x00, 0x00, 0x00, 0x6F, 0x3F, 0x01, 0x14, 0x7E,
+        0x00, 0x0A, 0x70, 0x00, 0x6F, 0x3F, 0x01, 0x14, 0x7E, 0x00, 0x0A, 0x70,
+        0x00, 0x6F, 0x3F, 0x01, 0x14, 0x7E, 0x00, 0x0A, 0x70, 0x00, 0x6F, 0x3F,
+        0x01, 0x14, 0x7E, 0x00, 0x0A, 0x70, 0x0F, 0x00, 0x00, 0x00, 0x6F, 0xFF,
+        0x01, 0x16, 0x9C, 0x00, 0x0B, 0x8F, 0x0B, 0x00, 0x00, 0x00, 0x97, 0xF0,
+        0x01, 0x3D, 0xE5, 0x00, 0x23, 0x42, 0x00, 0x97, 0xF0, 0x01, 0x3D, 0xE5,
+        0x00, 0x23, 0x42, 0x00, 0x97, 0xF0, 0x01, 0x3D, 0xE5, 0x00, 0x23, 0x42,
+        0x00, 0x97, 0xF0, 0x01, 0x3D, 0xE5, 0x00, 0x23, 0x42, 0x0F, 0x00, 0x00,
+        0x00, 0xFF, 0xEF, 0x01, 0xDD, 0xE3, 0x00, 0x7B, 0x42, 0x0F, 0x00, 0x00,
+        0x00, 0xFC, 0xBE, 0x01, 0xC9, 0xF2, 0x00, 0x69, 0x0A, 0x00, 0xFC, 0xBE,
+        0x01, 0xC9, 0xF2, 0x00, 0x69, 0x0A, 0x00, 0xFC, 0xBE, 0x01, 0xC9, 0xF2,
+        0x00, 0x69, 0x0A, 0x0F, 0x00, 0x00, 0x03, 0x7B, 0xDF, 0x0B, 0x00, 0x00,
+        0x0F, 0x6F, 0x3F, 0x0F, 0x00, 0x00, 0x03, 0x6F, 0xFF, 0x0B, 0x00, 0x00,
+        0x0F, 0x97, 0xF0, 0x0F, 0x00, 0x00, 0x03, 0xFF, 0xEF, 0x0F, 0x00, 0x00,
+        0x0B, 0xFC, 0xBE, 0x0F, 0x00, 0x00, 0x00, 0x7B, 0xDF, 0x02, 0x10, 0x8F,
+        0x0B, 0x00, 0x00, 0x00, 0x6F, 0x3F, 0x02, 0x0A, 0x70, 0x1B, 0x00, 0x00,
+        0x00, 0x6F, 0xFF, 0x02, 0x0B, 0x8F, 0x0B, 0x00, 0x00, 0x00, 0x97, 0xF0,
+        0x02, 0x23, 0x42, 0x0B, 0x00, 0x00, 0x00, 0x97, 0xF0, 0x02, 0x23, 0x42,
+        0x0B, 0x00, 0x00, 0x00, 0xFF, 0xEF, 0x02, 0x7B, 0x42, 0x0B, 0x00, 0x00,
+        0x00, 0xFC, 0xBE, 0x02, 0x69, 0x0A, 0x1B, 0x00, 0x00, 0x00, 0x7B, 0xDF,
+        0x01, 0x18, 0xFB, 0x00, 0x10, 0x8F, 0x0B, 0x00, 0x00, 0x00, 0x6F, 0x3F,
+        0x01, 0x14, 0x7E, 0x00, 0x0A, 0x70, 0x1B, 0x00, 0x00, 0x00, 0x6F, 0xFF,
+        0x01, 0x16, 0x9C, 0x00, 0x0B, 0x8F, 0x0B, 0x00, 0x00, 0x00, 0x97, 0xF0,
+        0x01, 0x3D, 0xE5, 0x00, 0x23, 0x42, 0x0B, 0x00, 0x00, 0x00, 0x97, 0xF0,
+        0x01, 0x3D, 0xE5, 0x00, 0x23, 0x42, 0x0B, 0x00, 0x00, 0x00, 0xFF, 0xEF,
+        0x01, 0xDD, 0xE3, 0x00, 0x7B, 0x42, 0x0B, 0x00, 0x00, 0x00, 0xFC, 0xBE,
+        0x01, 0xC9, 0xF2, 0x00, 0x69, 0x0A, 0x1B, 0x00, 0x00, 0x00, 0x7B, 0xDF,
+        0x01, 0x18, 0xFB, 0x00, 0x10, 0x8F, 0x0B, 0x00, 0x00, 0x00, 0x6F, 0x3F,
+        0x01, 0x14, 0x7E, 0x00, 0x0A, 0x70, 0x1B, 0x00, 0x00, 0x00, 0x6F, 0xFF,
+        0x01, 0x16, 0x9C, 0x00, 0x0B, 0x8F, 0x0B, 0x00, 0x00, 0x00, 0x97, 0xF0,
+        0x01, 0x3D, 0xE5, 0x00, 0x23, 0x42, 0x0B, 0x00, 0x00, 0x00, 0x97, 0xF0,
+        0x01, 0x3D, 0xE5, 0x00, 0x23, 0x42, 0x0B, 0x00, 0x00, 0x00, 0xFF, 0xEF,
+        0x01, 0xDD, 0xE3, 0x00, 0x7B, 0x42, 0x0B, 0x00, 0x00, 0x00, 0xFC, 0xBE,
+        0x01, 0xC9, 0xF2, 0x00, 0x69, 0x0A, 0x1B, 0x00, 0x00, 0x03, 0x7B, 0xDF,
+        0x0B, 0x00, 0x00, 0x03, 0x6F, 0x3F, 0x1B, 0x00, 0x00, 0x03, 0x6F, 0xFF,
+        0x0B, 0x00, 0x00, 0x03, 0x97, 0xF0, 0x0B, 0x00, 0x00, 0x03, 0x97, 0xF0,
+        0x0B, 0x00, 0x00, 0x03, 0xFF, 0xEF, 0x0B, 0x00, 0x00, 0x03, 0xFC, 0xBE,
+        0x13, 0x00, 0x00, 0x00, 0x7B, 0xDF, 0x02, 0x10, 0x8F, 0x00, 0x7B, 0xDF,
+        0x02, 0x10, 0x8F, 0x00, 0x7B, 0xDF, 0x02, 0x10, 0x8F, 0x00, 0x7B, 0xDF,
+        0x02, 0x10, 0x8F, 0x00, 0x7B, 0xDF, 0x02, 0x10, 0x8F, 0x03, 0x00, 0x00,
+        0x00, 0x6F, 0x3F, 0x02, 0x0A, 0x70, 0x00, 0x6F, 0x3F, 0x02, 0x0A, 0x70,
+        0x00, 0x6F, 0x3F, 0x02, 0x0A, 0x70, 0x00, 0x6F, 0x3F, 0x02, 0x0A, 0x70,
+        0x00, 0x6F, 0x3F, 0x02, 0x0A, 0x70, 0x03, 0x00, 0x00, 0x00, 0x6F, 0xFF,
+        0x02, 0x0B, 0x8F, 0x00, 0x6F, 0xFF, 0x02, 0x0B, 0x8F, 0x00, 0x6F, 0xFF,
+        0x02, 0x0B, 0x8F, 0x00, 0x6F, 0xFF, 0x02, 0x0B, 0x8F, 0x00, 0x6F, 0xFF,
+        0x02, 0x0B, 0x8F, 0x03, 0x00, 0x00, 0x00, 0x97, 0xF0, 0x02, 0x23, 0x42,
+        0x00, 0x97, 0xF0, 0x02, 0x23, 0x42, 0x00, 0x97, 0xF0, 0x02, 0x23, 0x42,
+        0x00, 0x97, 0xF0, 0x02, 0x23, 0x42, 0x07, 0x00, 0x00, 0x00, 0xFF, 0xEF,
+        0x02, 0x7B, 0x42, 0x00, 0xFF, 0xEF, 0x02, 0x7B, 0x42, 0x00, 0xFF, 0xEF,
+        0x02, 0x7B, 0x42, 0x00, 0xFF, 0xEF, 0x02, 0x7B, 0x42, 0x00, 0xFF, 0xEF,
+        0x02, 0x7B, 0x42, 0x07, 0x00, 0x00, 0x00, 0xFC, 0xBE, 0x02, 0x69, 0x0A,
+        0x00, 0xFC, 0xBE, 0x02, 0x69, 0x0A, 0x00, 0xFC, 0xBE, 0x02, 0x69, 0x0A,
+        0x00, 0xFC, 0xBE, 0x02, 0x69, 0x0A, 0x03, 0x00, 0x00, 0x00, 0x7B, 0xDF,
+        0x01, 0x18, 0xFB, 0x00, 0x10, 0x8F, 0x00, 0x7B, 0xDF, 0x01, 0x18, 0xFB,
+        0x00, 0x10, 0x8F, 0x00, 0x7B, 0xDF, 0x01, 0x18, 0xFB, 0x00, 0x10, 0x8F,
+        0x00, 0x7B, 0xDF, 0x01, 0x18, 0xFB, 0x00, 0x10, 0x8F, 0x00, 0x7B, 0xDF,
+        0x01, 0x18, 0xFB, 0x00, 0x10, 0x8F, 0x03, 0x00, 0x00, 0x00, 0x6F, 0x3F,
+        0x01, 0x14, 0x7E, 0x00, 0x0A, 0x70, 0x00, 0x6F, 0x3F, 0x01, 0x14, 0x7E,
+        0x00, 0x0A, 0x70, 0x00, 0x6F, 0x3F, 0x01, 0x14, 0x7E, 0x00, 0x0A, 0x70,
+        0x00, 0x6F, 0x3F, 0x01, 0x14, 0x7E, 0x00, 0x0A, 0x70, 0x00, 0x6F, 0x3F,
+        0x01, 0x14, 0x7E, 0x00, 0x0A, 0x70, 0x03, 0x00, 0x00, 0x00, 0x6F, 0xFF,
+        0x01, 0x16, 0x9C, 0x00, 0x0B, 0x8F, 0x00, 0x6F, 0xFF, 0x01, 0x16, 0x9C,
+        0x00, 0x0B, 0x8F, 0x00, 0x6F, 0xFF, 0x01, 0x16, 0x9C, 0x00, 0x0B, 0x8F,
+        0x00, 0x6F, 0xFF, 0x01, 0x16, 0x9C, 0x00, 0x0B, 0x8F, 0x00, 0x6F, 0xFF,
+        0x01, 0x16, 0x9C, 0x00, 0x0B, 0x8F, 0x03, 0x00, 0x00, 0x00, 0x97, 0xF0,
+        0x01, 0x3D, 0xE5, 0x00, 0x23, 0x42, 0x00, 0x97, 0xF0, 0x01, 0x3D, 0xE5,
+        0x00, 0x23, 0x42, 0x00, 0x97, 0xF0, 0x01, 0x3D, 0xE5, 0x00, 0x23, 0x42,
+        0x00, 0x97, 0xF0, 0x01, 0x3D, 0xE5, 0x00, 0x23, 0x42, 0x07, 0x00, 0x00,
+        0x00, 0xFF, 0xEF, 0x01, 0xDD, 0xE3, 0x00, 0x7B, 0x42, 0x00, 0xFF, 0xEF,
+        0x01, 0xDD, 0xE3, 0x00, 0x7B, 0x42, 0x00, 0xFF, 0xEF, 0x01, 0xDD, 0xE3,
+        0x00, 0x7B, 0x42, 0x00, 0xFF, 0xEF, 0x01, 0xDD, 0xE3, 0x00, 0x7B, 0x42,
+        0x00, 0xFF, 0xEF, 0x01, 0xDD, 0xE3, 0x00, 0x7B, 0x42, 0x07, 0x00, 0x00,
+        0x00, 0xFC, 0xBE, 0x01, 0xC9, 0xF2, 0x00, 0x69, 0x0A, 0x00, 0xFC, 0xBE,
+        0x01, 0xC9, 0xF2, 0x00, 0x69, 0x0A, 0x00, 0xFC, 0xBE, 0x01, 0xC9, 0xF2,
+        0x00, 0x69, 0x0A, 0x00, 0xFC, 0xBE, 0x01, 0xC9, 0xF2, 0x00, 0x69, 0x0A,
+        0x03, 0x00, 0x00, 0x00, 0x7B, 0xDF, 0x01, 0x18, 0xFB, 0x00, 0x10, 0x8F,
+        0x00, 0x7B, 0xDF, 0x01, 0x18, 0xFB, 0x00, 0x10, 0x8F, 0x00, 0x7B, 0xDF,
+        0x01, 0x18, 0xFB, 0x00, 0x10, 0x8F, 0x00, 0x7B, 0xDF, 0x01, 0x18, 0xFB,
+        0x00, 0x10, 0x8F, 0x00, 0x7B, 0xDF, 0x01, 0x18, 0xFB, 0x00, 0x10, 0x8F,
+        0x03, 0x00, 0x00, 0x00, 0x6F, 0x3F, 0x01, 0x14, 0x7E, 0x00, 0x0A, 0x70,
+        0x00, 0x6F, 0x3F, 0x01, 0x14, 0x7E, 0x00, 0x0A, 0x70, 0x00, 0x6F, 0x3F,
+        0x01, 0x14, 0x7E, 0x00, 0x0A, 0x70, 0x00, 0x6F, 0x3F, 0x01, 0x14, 0x7E,
+        0x00, 0x0A, 0x70, 0x00, 0x6F, 0x3F, 0x01, 0x14, 0x7E, 0x00, 0x0A, 0x70,
+        0x03, 0x00, 0x00, 0x00, 0x6F, 0xFF, 0x01, 0x16, 0x9C, 0x00, 0x0B, 0x8F,
+        0x00, 0x6F, 0xFF, 0x01, 0x16, 0x9C, 0x00, 0x0B, 0x8F, 0x00, 0x6F, 0xFF,
+        0x01, 0x16, 0x9C, 0x00, 0x0B, 0x8F, 0x00, 0x6F, 0xFF, 0x01, 0x16, 0x9C,
+        0x00, 0x0B, 0x8F, 0x00, 0x6F, 0xFF, 0x01, 0x16, 0x9C, 0x00, 0x0B, 0x8F,
+        0x03, 0x00, 0x00, 0x00, 0x97, 0xF0, 0x01, 0x3D, 0xE5, 0x00, 0x23, 0x42,
+        0x00, 0x97, 0xF0, 0x01, 0x3D, 0xE5, 0x00, 0x23, 0x42, 0x00, 0x97, 0xF0,
+        0x01, 0x3D, 0xE5, 0x00, 0x23, 0x42, 0x00, 0x97, 0xF0, 0x01, 0x3D, 0xE5,
+        0x00, 0x23, 0x42, 0x07, 0x00, 0x00, 0x00, 0xFF, 0xEF, 0x01, 0xDD, 0xE3,
+        0x00, 0x7B, 0x42, 0x00, 0xFF, 0xEF, 0x01, 0xDD, 0xE3, 0x00, 0x7B, 0x42,
+        0x00, 0xFF, 0xEF, 0x01, 0xDD, 0xE3, 0x00, 0x7B, 0x42, 0x00, 0xFF, 0xEF,
+        0x01, 0xDD, 0xE3, 0x00, 0x7B, 0x42, 0x00, 0xFF, 0xEF, 0x01, 0xDD, 0xE3,
+        0x00, 0x7B, 0x42, 0x07, 0x00, 0x00, 0x00, 0xFC, 0xBE, 0x01, 0xC9, 0xF2,
+        0x00, 0x69, 0x0A, 0x00, 0xFC, 0xBE, 0x01, 0xC9, 0xF2, 0x00, 0x69, 0x0A,
+        0x00, 0xFC, 0xBE, 0x01, 0xC9, 0xF2, 0x00, 0x69, 0x0A, 0x00, 0xFC, 0xBE,
+        0x01, 0xC9, 0xF2, 0x00, 0x69, 0x0A, 0x03, 0x00, 0x00, 0x13, 0x7B, 0xDF,
+        0x03, 0x00, 0x00, 0x13, 0x6F, 0x3F, 0x03, 0x00, 0x00, 0x13, 0x6F, 0xFF,
+        0x03, 0x00, 0x00, 0x0F, 0x97, 0xF0, 0x07, 0x00, 0x00, 0x13, 0xFF, 0xEF,
+        0x07, 0x00, 0x00, 0x0F, 0xFC, 0xBE, 0xFF, 0x00, 0x00, 0x21, 0x00, 0x00,
+};
+
+const sprite_t Sprite_Logo = { 144, // Width
+        24, // Height
+        SPRITE_RLE565, // Format
+        0, // Palette size
+        (void*) 0, Logo_Data, 2280 };
@@ -0,0 +1,278 @@
+// benchmarks.c
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-26
+// Startup benchmarks, reported over UART. Meant to be run from main before
+// G8RTOS_Launch, while nothing else is using the display.
+
+/************************************Includes***************************************/
+
+#include "./benchmarks.h"
+#include "./MultimodDrivers/multimod.h"
+#include "./G8RTOS/G8RTOS_Clock.h"
+#include <driverlib/uartstdio.h>
+#include <string.h>
+
+/************************************Includes***************************************/
+
+/*******************************Private Variables***********************************/
+
+// Bits sent per pixel in the color mode being measured
+static uint8_t pixelBits = 16;
+
+/*******************************Private Variables***********************************/
+
+/********************************Private Functions**********************************/
+
+// PixelBytes
+// Bytes sent for a number of pixels in the color mode being measured.
+// Return: uint32_t
+static uint32_t PixelBytes(uint32_t pixels)
+{
+    return pixels * pixelBits / 8;
+}
+
+// Benchmark_Fill
+// Full-screen fill, sent by the uDMA.
+// Return: void
+static void Benchmark_Fill(void)
+{
+    uint64_t start = G8RTOS_GetTimeNs();
+
+    for (uint8_t i = 0; i < BENCHMARK_PASSES; i++)
+        ST7789_Fill(i & 1 ? ST7789_WHITE : ST7789_BLACK);
+
+    Benchmark_Report("ST7789_Fill", PixelBytes(BENCHMARK_PASSES * X_MAX * Y_MAX),
+                     G8RTOS_GetTimeNs() - start);
+}
+
+// Benchmark_FillLines
+// Full screen as single rows, each below the uDMA threshold so the data
+// goes through the TX FIFO. Includes the window overhead of every row.
+// Return: void
+static void Benchmark_FillLines(void)
+{
+    uint64_t start = G8RTOS_GetTimeNs();
+
+    for (uint8_t i = 0; i < BENCHMARK_PASSES; i++)
+    {
+        for (uint16_t y = 0; y < Y_MAX; y++)
+            ST7789_DrawRectangle(0, y, X_MAX, 1, i & 1 ? ST7789_WHITE : ST7789_BLACK);
+    }
+
+    Benchmark_Report("ST7789 row fill", PixelBytes(BENCHMARK_PASSES * X_MAX * Y_MAX),
+                     G8RTOS_GetTimeNs() - start);
+}
+
+// Benchmark_Rectangles
+// Full screen as 10x10 rectangles, the size of a board cell. Then again
+// with each pass sent as one batch, so the rectangles share a single CS
+// assertion like a rendered display list.
+// Return: void
+static void Benchmark_Rectangles(void)
+{
+    for (uint8_t batch = 0; batch < 2; batch++)
+    {
+        uint64_t start = G8RTOS_GetTimeNs();
+
+        for (uint8_t i = 0; i < BENCHMARK_PASSES; i++)
+        {
+            if (batch)
+                ST7789_BeginBatch();
+            for (uint16_t y = 0; y < Y_MAX; y += 10)
+            {
+                for (uint16_t x = 0; x < X_MAX; x += 10)
+                    ST7789_DrawRectangle(x, y, 10, 10, i & 1 ? ST7789_WHITE : ST7789_BLACK);
+            }
+            if (batch)
+                ST7789_EndBatch();
+        }
+
+        Benchmark_Report(batch ? "  batched" : "ST7789_DrawRectangle 10x10",
+                         PixelBytes(BENCHMARK_PASSES * X_MAX * Y_MAX),
+                         G8RTOS_GetTimeNs() - start);
+    }
+}
+
+// Benchmark_Text
+// Draws the UI strings, counting SPI bytes as one window per string.
+// Also prints what the old window per pixel drawing sent, and characters
+// per second ("!" is not in the glyph cache, so the last string measures
+// the bitmap path).
+// Return: void
+static void Benchmark_Text(void)
+{
+    static const char *strings[] = { "HIGH", "SCORE", "LEVEL", "123456", "!!!!!!" };
+
+    for (uint8_t s = 0; s < sizeof(strings) / sizeof(strings[0]); s++)
+    {
+        uint32_t pixels = (uint32_t) ST7789_GetTextWidth(&FontStyle_Emulogic, strings[s])
+                * FontStyle_Emulogic.GlyphHeight;
+        uint32_t chars = BENCHMARK_PASSES * (uint32_t) strlen(strings[s]);
+        uint64_t start = G8RTOS_GetTimeNs();
+        uint64_t ns;
+
+        for (uint8_t i = 0; i < BENCHMARK_PASSES; i++)
+            ST7789_DrawText(&FontStyle_Emulogic, strings[s], 0, 0, ST7789_WHITE, ST7789_BLACK);
+
+        ns = G8RTOS_GetTimeNs() - start;
+        Benchmark_Report(strings[s],
+                         BENCHMARK_PASSES * (BENCHMARK_WINDOW_BYTES + PixelBytes(pixels)), ns);
+        UARTprintf("  was %u bytes, %u chars/s\n",
+                   BENCHMARK_PASSES * pixels * (BENCHMARK_WINDOW_BYTES + 2),
+                   ns ? (uint32_t) ((uint64_t) chars * 1000000000 / ns) : 0);
+    }
+}
+
+// Benchmark_ColorMode
+// Repeats the fill, rectangle and text measurements in RGB444 mode, 12
+// bits per pixel instead of 16.
+// Return: void
+static void Benchmark_ColorMode(void)
+{
+    uint8_t mode = ST7789_GetColorMode();
+    uint8_t bits = pixelBits;
+
+    UARTprintf("RGB444 (12-bit pixel frames):\n");
+
+    ST7789_SetColorMode(ST7789_COLMOD_RGB444);
+    pixelBits = 12;
+
+    Benchmark_Fill();
+    Benchmark_Rectangles();
+    Benchmark_Text();
+
+    ST7789_SetColorMode(mode);
+    pixelBits = bits;
+}
+
+// Benchmark_Sprite
+// Tiles the screen with a sprite, then with a raw bitmap of the same size
+// sent by ST7789_DrawBitmap. The raw bitmap is read from the start of
+// flash, so it draws garbage but moves the same number of bytes.
+// Param char* "name": what is measured
+// Param sprite_t* "sprite": sprite to tile
+// Return: void
+static void Benchmark_Sprite(const char *name, const sprite_t *sprite)
+{
+    uint16_t w = sprite->Width, h = sprite->Height;
+    uint32_t tiles = (uint32_t) (X_MAX / w) * (Y_MAX / h);
+    uint32_t bytes = BENCHMARK_PASSES * tiles * w * h * 2;
+    uint64_t start = G8RTOS_GetTimeNs();
+
+    for (uint8_t i = 0; i < BENCHMARK_PASSES; i++)
+    {
+        for (uint16_t y = 0; y + h <= Y_MAX; y += h)
+        {
+            for (uint16_t x = 0; x + w <= X_MAX; x += w)
+                ST7789_DrawSprite(sprite, x, y);
+        }
+    }
+
+    Benchmark_Report(name, bytes, G8RTOS_GetTimeNs() - start);
+
+    start = G8RTOS_GetTimeNs();
+
+    for (uint8_t i = 0; i < BENCHMARK_PASSES; i++)
+    {
+        for (uint16_t y = 0; y + h <= Y_MAX; y += h)
+        {
+            for (uint16_t x = 0; x + w <= X_MAX; x += w)
+                ST7789_DrawBitmap(x, y, w, h, (const uint8_t*) 0);
+        }
+    }
+
+    Benchmark_Report("  raw bitmap", bytes, G8RTOS_GetTimeNs() - start);
+    UARTprintf("  %u bytes of flash, %u raw\n", sprite->DataSize + sprite->PaletteSize * 2,
+               (uint32_t) w * h * 2);
+}
+
+// Benchmark_Partial
+// Redraws the game board as 10x10 cells with only the board refreshed, in
+// partial mode and in partial idle mode, and times switching into each
+// and back. The bytes sent are the same as in normal mode, the panel just
+// scans fewer lines. Also times a sleep and wake, mostly the SLPIN and
+// SLPOUT delays.
+// Return: void
+static void Benchmark_Partial(void)
+{
+    static const st7789Mode_t modes[] = { ST7789_MODE_PARTIAL, ST7789_MODE_PARTIAL_IDLE };
+    static const char *names[] = { "partial board 10x10", "partial idle board 10x10" };
+    uint32_t pixels = BENCHMARK_PASSES * BENCHMARK_BOARD_W * BENCHMARK_BOARD_H;
+    uint64_t start;
+
+    ST7789_SetPartialArea(BENCHMARK_BOARD_Y, BENCHMARK_BOARD_H);
+
+    for (uint8_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++)
+    {
+        start = G8RTOS_GetTimeNs();
+        ST7789_SetMode(modes[m]);
+        UARTprintf("%s: switch in %u us\n", names[m],
+                   (uint32_t) ((G8RTOS_GetTimeNs() - start) / 1000));
+
+        start = G8RTOS_GetTimeNs();
+        for (uint8_t i = 0; i < BENCHMARK_PASSES; i++)
+        {
+            for (uint16_t y = 0; y < BENCHMARK_BOARD_H; y += 10)
+            {
+                for (uint16_t x = 0; x < BENCHMARK_BOARD_W; x += 10)
+                {
+                    ST7789_DrawRectangle(BENCHMARK_BOARD_X + x, BENCHMARK_BOARD_Y + y, 10, 10,
+                                         i & 1 ? ST7789_WHITE : ST7789_BLACK);
+                }
+            }
+        }
+        Benchmark_Report(names[m], PixelBytes(pixels), G8RTOS_GetTimeNs() - start);
+
+        start = G8RTOS_GetTimeNs();
+        ST7789_SetMode(ST7789_MODE_NORMAL);
+        UARTprintf("  back to normal in %u us\n",
+                   (uint32_t) ((G8RTOS_GetTimeNs() - start) / 1000));
+    }
+
+    start = G8RTOS_GetTimeNs();
+    ST7789_SetMode(ST7789_MODE_SLEEP);
+    ST7789_SetMode(ST7789_MODE_NORMAL);
+    UARTprintf("sleep and wake: %u us\n", (uint32_t) ((G8RTOS_GetTimeNs() - start) / 1000));
+}
+
+/********************************Private Functions**********************************/
+
+/********************************Public Functions***********************************/
+
+// Benchmark_Report
+// Prints the time taken and effective throughput of a measurement.
+// Param char* "name": what was measured
+// Param uint32_t "bytes": pixel bytes sent over SPI
+// Param uint64_t "ns": elapsed time
+// Return: void
+void Benchmark_Report(const char *name, uint32_t bytes, uint64_t ns)
+{
+    uint32_t rate = ns ? (uint32_t) ((uint64_t) bytes * 1000000000 / ns) : 0;
+
+    UARTprintf("%s: %u bytes in %u us, %u bytes/s\n", name, bytes, (uint32_t) (ns / 1000),
+               rate);
+}
+
+// Benchmark_Run
+// Runs all benchmarks and leaves the screen black.
+// Return: void
+void Benchmark_Run(void)
+{
+    pixelBits = ST7789_GetColorMode() == ST7789_COLMOD_RGB444 ? 12 : 16;
+
+    UARTprintf("Benchmarks (%u passes, %u-bit pixel frames):\n", BENCHMARK_PASSES,
+               ST7789_PIXEL_FRAME_SIZE);
+
+    Benchmark_Fill();
+    Benchmark_FillLines();
+    Benchmark_Rectangles();
+    Benchmark_Text();
+    Benchmark_Sprite("Sprite_Block", &Sprite_Block);
+    Benchmark_Sprite("Sprite_Logo", &Sprite_Logo);
+    Benchmark_ColorMode();
+    Benchmark_Partial();
+
+    ST7789_Fill(ST7789_BLACK);
+}
+
+/********************************Public Functions***********************************/
@@ -0,0 +1,39 @@
+// benchmarks.h
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-26
+// Startup benchmarks, reported over UART
+
+#ifndef BENCHMARKS_H_
+#define BENCHMARKS_H_
+
+/************************************Includes***************************************/
+
+#include <stdint.h>
+
+/************************************Includes***************************************/
+
+/*************************************Defines***************************************/
+
+// Passes averaged per measurement
+#define BENCHMARK_PASSES        4
+
+// CASET, RASET and RAMWR with their parameters
+#define BENCHMARK_WINDOW_BYTES  11
+
+// Game board, the area Benchmark_Partial refreshes (FRAME_X_OFF and
+// FRAME_Y_OFF in boardgrid.h)
+#define BENCHMARK_BOARD_X       60
+#define BENCHMARK_BOARD_Y       83
+#define BENCHMARK_BOARD_W       100
+#define BENCHMARK_BOARD_H       200
+
+/*************************************Defines***************************************/
+
+/********************************Public Functions***********************************/
+
+void Benchmark_Report(const char *name, uint32_t bytes, uint64_t ns);
+void Benchmark_Run(void);
+
+/********************************Public Functions***********************************/
+
+#endif /* BENCHMARKS_H_ */
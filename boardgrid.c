@@ -0,0 +1,76 @@
+// boardgrid.c
+// Date Created: 2023-07-27
+// Date Updated: 2023-07-27
+// Pattern the game board is painted with, the frame outline around a grid
+// of empty cells.
+
+/************************************Includes***************************************/
+
+#include "./boardgrid.h"
+
+#include <stdbool.h>
+
+/************************************Includes***************************************/
+
+/*******************************Private Variables***********************************/
+
+static uint16_t grid_tile[GRID_TILE * GRID_TILE];
+static const st7789Pattern_t grid_pattern = { grid_tile, GRID_TILE, GRID_TILE, GRID_EDGE };
+
+/*******************************Private Variables***********************************/
+
+/********************************Private Functions**********************************/
+
+// color of a pixel of the board pattern tile
+static uint16_t gridTileColor(uint8_t x, uint8_t y)
+{
+    // tile rows and columns 2 to GRID_TILE - 3 repeat, starting at the
+    // second row and column of the board
+    uint8_t row = (y + BLOCK_SIZE + 1 - GRID_EDGE) % BLOCK_SIZE;
+    uint8_t col = (x + BLOCK_SIZE + 1 - GRID_EDGE) % BLOCK_SIZE;
+    bool midRow = y >= GRID_EDGE && y < GRID_TILE - GRID_EDGE;
+    bool midCol = x >= GRID_EDGE && x < GRID_TILE - GRID_EDGE;
+
+    if (!x || !y || x == GRID_TILE - 1 || y == GRID_TILE - 1)
+        return 0xFFFF;
+
+    // two pixel wide lines between the cells
+    if (midRow && (row == 0 || row == BLOCK_SIZE - 1))
+        return DARK_GRAY;
+    if (midCol && (col == 0 || col == BLOCK_SIZE - 1))
+        return DARK_GRAY;
+
+#ifdef BOARD_SCROLL_LAYOUT
+    // the board edges wrap into the middle when scrolled, so they get lines too
+    if (!midRow)
+        return DARK_GRAY;
+#endif
+
+    return 0;
+}
+
+/********************************Private Functions**********************************/
+
+/********************************Public Functions***********************************/
+
+// BoardGrid_Pattern
+// Pattern to fill the GRID_X, GRID_Y, GRID_W, GRID_H window with. The tile
+// is built on the first call.
+// Return: const st7789Pattern_t*
+const st7789Pattern_t *BoardGrid_Pattern(void)
+{
+    if (!grid_tile[0])
+    {
+        for (uint8_t y = 0; y < GRID_TILE; y++)
+        {
+            for (uint8_t x = 0; x < GRID_TILE; x++)
+            {
+                grid_tile[y * GRID_TILE + x] = gridTileColor(x, y);
+            }
+        }
+    }
+
+    return &grid_pattern;
+}
+
+/********************************Public Functions***********************************/
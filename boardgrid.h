@@ -0,0 +1,49 @@
+// boardgrid.h
+// Date Created: 2023-07-27
+// Date Updated: 2023-07-27
+// Geometry of the game board and the pattern its frame, crosshatch grid and
+// empty cells are painted with. Kept apart from the threads so
+// tools/st7789emu can draw the same tile.
+
+#ifndef BOARDGRID_H_
+#define BOARDGRID_H_
+
+/************************************Includes***************************************/
+
+#include "./MultimodDrivers/multimod_ST7789.h"
+
+/************************************Includes***************************************/
+
+/*************************************Defines***************************************/
+
+#define ROWS 20
+#define COLS 10
+#define FRAME_X_OFF 60
+#define FRAME_Y_OFF 83
+#define BLOCK_SIZE 10
+#define DARK_GRAY 0x31A6
+
+// Uncomment to move the HUD and previews out of the board rows, so line
+// clears can shift the board with hardware scrolling
+//#define BOARD_SCROLL_LAYOUT
+
+// tile of the board pattern, one cell between two pixel edges: the frame
+// outline and the outer row or column of the board, which no cell reaches
+#define GRID_EDGE 2
+#define GRID_TILE (BLOCK_SIZE + 2 * GRID_EDGE)
+
+// window the pattern fills, the board and its frame outline
+#define GRID_X (FRAME_X_OFF - 1)
+#define GRID_Y (FRAME_Y_OFF - 1)
+#define GRID_W (BLOCK_SIZE * COLS + 2)
+#define GRID_H (BLOCK_SIZE * ROWS + 2)
+
+/*************************************Defines***************************************/
+
+/********************************Public Functions***********************************/
+
+const st7789Pattern_t *BoardGrid_Pattern(void);
+
+/********************************Public Functions***********************************/
+
+#endif /* BOARDGRID_H_ */
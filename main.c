@@ -17,10 +17,19 @@
 
 #include "./threads.h"
 #include "./G8RTOS/G8RTOS_IPC.h"
+#include "./benchmarks.h"
 
 /************************************Includes***************************************/
 
 /*************************************Defines***************************************/
+
+// Uncomment to print display benchmarks over UART at startup
+//#define RUN_BENCHMARKS
+
+// Uncomment to start drawing at the ST7789 TE vsync (needs TE jumpered to
+// FRAMEPACER_TE_PIN), frame timing is printed at game over
+//#define FRAME_PACING
+
 /*************************************Defines***************************************/
 
 /********************************Public Variables***********************************/
@@ -60,22 +69,40 @@ int main(void)
 
     UARTprintf("\n-----------\nSystem Restarted - UART Online.\n\n");
 
+    // raise the display write clock as far as RAMRD readback confirms
+    UARTprintf("ST7789 write clock: %u Hz\n", ST7789_ProbeClock());
+
+#ifdef RUN_BENCHMARKS
+    Benchmark_Run();
+#endif
+
     // Add threads, initialize semaphores here!
     G8RTOS_InitSemaphore(&sem_UART, 1);
     G8RTOS_InitSemaphore(&sem_gameEnd, 0);
     G8RTOS_InitSemaphore(&sem_clearLine, 0);
     G8RTOS_InitSemaphore(&sem_lost, 0);
     G8RTOS_InitSemaphore(&sem_update_ui, 1);
+    G8RTOS_InitSemaphore(&sem_cells, 1);
 
     G8RTOS_InitFIFO(0);
     G8RTOS_InitFIFO(1);
 
+    lost_timer = G8RTOS_CreateTimer(Lost_Timer, 500, TIMER_ONE_SHOT);
+
+#ifdef FRAME_PACING
+    FramePacer_Init();
+#endif
+
     G8RTOS_AddThread(FallingBlock_Thread, 252, "Fall", 2);
     G8RTOS_AddThread(DrawUI_Thread, 251, "UI", 1);
     G8RTOS_AddThread(StaticBlocks_Thread, 250, "Stat", 3);
     G8RTOS_AddThread(Lost_Thread, 249, "Lost", 4);
+    G8RTOS_AddThread(Render_Thread, 253, "Render", 5);
 
     G8RTOS_Add_PeriodicEvent(Get_Input_P, 5, 50, 1);
+
+    // the piece shadow is looked up instead of searched for on every move
+    G8RTOS_AddIdleHook(shadowIdleHook);
     //JOYSTICK_IntEnable();
 
     G8RTOS_Launch();
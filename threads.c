@@ -6,6 +6,7 @@
 /************************************Includes***************************************/
 
 #include "./threads.h"
+#include "./boardgrid.h"
 #include "./MultimodDrivers/multimod.h"
 #include <driverlib/uart.h>
 #include <driverlib/interrupt.h>
@@ -31,19 +32,12 @@
 //#define delay_0_1_s     (1600000/3)
 #define thread_delay     (1600000/16)
 
-#define ROWS 20
-#define COLS 10
 #define BLOCKS_ARRAY_SIZE ((ROWS * COLS + 7) / 8)
 #define BITS_PER_BYTE 8
 #define JOYSTICK_MIDPOINT 2100
 #define JOYSTICK_DEADZONE 500
 #define NUM_SHAPES 7
-#define FRAME_X_OFF 60
-#define FRAME_Y_OFF 83
-#define BLOCK_SIZE 10
-#define DARK_GRAY 0x31A6
 #define GRAY 0xAD55
-#define SHADOW_COLOR colors[curBlock]
 
 #define START_X 3
 #define START_Y ROWS - 2
@@ -55,9 +49,52 @@
 #define MOVE_ROTATE 4
 #define MOVE_INSTADROP 5
 #define MOVE_SWAP 6
+#define MOVE_PAUSE 7
 
 #define FONT_WIDTH 8
 
+// HUD numbers are right aligned to the end of their 5 character label and
+// may stick out one character to the left of it
+#define UI_NUM_DIGITS 6
+#define UI_NUM_RIGHT(label_x) ((label_x) + 5 * FONT_WIDTH)
+
+#ifdef BOARD_SCROLL_LAYOUT
+// HUD above the board, previews below it
+#define UI_HIGH_X 20
+#define UI_SCORE_X 100
+#define UI_LEVEL_X 180
+#define UI_HIGH_Y (Y_MAX - 14)
+#define UI_SCORE_Y UI_HIGH_Y
+#define UI_LEVEL_Y UI_HIGH_Y
+#define UI_NUM_OFF 14
+
+#define PREVIEW_X(k) (5 + (k) * 46)
+#define PREVIEW_Y(k) (FRAME_Y_OFF - 5 * BLOCK_SIZE)
+#else
+// left edge of the 5 character UI labels
+#define UI_TEXT_X (FRAME_X_OFF - (5 * FONT_WIDTH) - 2)
+#define UI_HIGH_X UI_TEXT_X
+#define UI_SCORE_X UI_TEXT_X
+#define UI_LEVEL_X UI_TEXT_X
+#define UI_HIGH_Y (FRAME_Y_OFF + 10 * BLOCK_SIZE)
+#define UI_SCORE_Y (FRAME_Y_OFF + 6 * BLOCK_SIZE)
+#define UI_LEVEL_Y (FRAME_Y_OFF + 2 * BLOCK_SIZE)
+#define UI_NUM_OFF (BLOCK_SIZE + 2)
+
+// held piece left of the board, lookahead stacked down the right
+#define PREVIEW_X(k) ((k) ? FRAME_X_OFF + COLS * BLOCK_SIZE : FRAME_X_OFF - 4 * BLOCK_SIZE)
+#define PREVIEW_Y(k) ((k) ? FRAME_Y_OFF + (ROWS + 1 - 5 * (k)) * BLOCK_SIZE : \
+                            FRAME_Y_OFF + (ROWS - 4) * BLOCK_SIZE)
+#endif
+
+// display states, setScreen switches the panel mode to match. Paused and
+// game over only refresh the board and its outline, paused in 8 colors.
+#define SCREEN_PLAYING 0
+#define SCREEN_PAUSED 1
+#define SCREEN_GAME_OVER 2
+#define SCREEN_PARTIAL_TOP (FRAME_Y_OFF - 1)
+#define SCREEN_PARTIAL_HEIGHT (BLOCK_SIZE * ROWS + 2)
+
 #define STRAIGHT_UP blockRotation % 2 - 1
 #define HORIZONTAL 1
 
@@ -69,15 +106,32 @@
 
 #define ROT_VERTICAL (blockRotation - 1) % 2
 
+// columns the 3x3 grid of a piece can be at, from -1 (left column empty)
+#define SHADOW_X_MIN -1
+#define SHADOW_COLS COLS
+
 // maximum value is NUM_SHAPES
 #define PREVIEW_COUNT 4
 
+// area of a preview slot that pieces are drawn in, one pixel in from
+// PREVIEW_X and PREVIEW_Y
+#define PREVIEW_W (4 * BLOCK_SIZE - 2)
+#define PREVIEW_H (4 * BLOCK_SIZE)
+
+// board cell states, shadows are drawn as an outline in the piece color
+#define CELL_EMPTY 0
+#define CELL_PIECE(shape) (1 + (shape))
+#define CELL_SHADOW(shape) (1 + NUM_SHAPES + (shape))
+#define CELL_STATIC (1 + 2 * NUM_SHAPES)
+#define CELL_IS_SHADOW(state) ((state) >= CELL_SHADOW(0) && (state) < CELL_STATIC)
+
 uint32_t highscore = 0;
 uint8_t line_count = 1;
 uint8_t blockRotation = 1;
 int8_t blockY = START_Y;
 int8_t blockX = START_X;
 uint8_t resetting = 0;
+uint8_t screen = SCREEN_PLAYING;
 uint8_t hold_allowed = 1;
 uint32_t timer = 0;
 uint32_t score = 0;
@@ -90,9 +144,54 @@ int8_t shadowX[4] = { -1 };
 int8_t shadowY[4] = { -1 };
 
 unsigned char static_blocks[BLOCKS_ARRAY_SIZE] = { 0 };
-unsigned char old_static_blocks[BLOCKS_ARRAY_SIZE] = { 0 };
+// bumped on every change to static_blocks, so shadow_table can tell it's stale
+uint32_t static_gen = 0;
 char piece_grab_bag[NUM_SHAPES * 2] = { 255 };
 
+const uint16_t pieceColors[NUM_SHAPES] = { 0xF800, 0x055F, 0x07E0, 0xF81F, 0x001F, 0x07FF,
+                                           0xFFE0 };
+
+// wanted and last drawn state of every board cell, flushCells draws the
+// dirty cells where the two differ
+uint8_t cells[ROWS * COLS] = { CELL_EMPTY };
+uint8_t drawn_cells[ROWS * COLS] = { CELL_EMPTY };
+unsigned char dirty_cells[BLOCKS_ARRAY_SIZE] = { 0 };
+
+// https://i.pinimg.com/736x/07/bf/d7/07bfd7e344183c428d841cf2813de97a.jpg
+// 1x4 is 5, 2x2 is 6
+
+// 3x3 grid (middle always filled)
+// 0 1 2
+// 3 F 4
+// 5 6 7
+const unsigned char shapes[4][NUM_SHAPES] = { { 0b10011000, 0b00111000, 0b01110000, 0b01011000,
+                                                0b11001000, 0b00010110, 0b00011000 },
+                                              { 0b01100010, 0b01000011, 0b01001001, 0b01001010,
+                                                0b00101010, 0b00010110, 0b01000010 },
+                                              { 0b00011001, 0b00011100, 0b00001110, 0b00011010,
+                                                0b00010011, 0b00010110, 0b00011000 },
+                                              { 0b01000110, 0b11000010, 0b10010010, 0b01010010,
+                                                0b01010100, 0b00010110, 0b01000010 } };
+
+// rows the current piece comes to rest at for every rotation and column,
+// worked out by shadowIdleHook while nothing else runs. Entries are for a
+// drop from shadow_table_y, which holds for any row from there down to the
+// entry itself, on static_blocks at shadow_table_gen.
+int8_t shadow_table[4][SHADOW_COLS];
+uint64_t shadow_valid = 0;
+uint8_t shadow_next = 0;
+uint8_t shadow_table_piece = NUM_SHAPES;
+int8_t shadow_table_y = 0;
+uint32_t shadow_table_gen = 0;
+
+// held piece (0) and lookahead previews, composed in RAM so each slot is
+// one window of only the rows that changed
+compositor_t previewSlots[PREVIEW_COUNT + 1];
+
+// rows the board has been hardware scrolled by, row r is drawn at
+// (r + board_scroll) % ROWS in the frame memory
+uint8_t board_scroll = 0;
+
 /*************************************Defines***************************************/
 
 /********************************Public Functions***********************************/
@@ -100,7 +199,17 @@ char piece_grab_bag[NUM_SHAPES * 2] = { 255 };
 void Idle_Thread()
 {
     while (1)
-        ;
+    {
+        G8RTOS_RunIdleHooks();
+    }
+}
+
+void Render_Thread()
+{
+    while (true)
+    {
+        DisplayList_Render();
+    }
 }
 
 void Lost_Thread()
@@ -109,14 +218,14 @@ void Lost_Thread()
     {
         G8RTOS_WaitSemaphore(&sem_lost);
 
-        G8RTOS_Sleep(500);
-
         for (uint8_t i = 0; i < BLOCKS_ARRAY_SIZE; i++)
         {
             static_blocks[i] = 0;
         }
+        static_gen++;
 
         UARTprintf("Score: %d\n", score);
+        FramePacer_Report();
         if (score > highscore)
         {
             highscore = score;
@@ -126,9 +235,7 @@ void Lost_Thread()
 
         G8RTOS_Change_Period(GRAVITY_THREAD_ID, (uint32_t) START_SPEED);
 
-        ST7789_DrawRectangle(FRAME_X_OFF, FRAME_Y_OFF,
-        BLOCK_SIZE * COLS - 1,
-                             BLOCK_SIZE * ROWS - 1, 0);
+        resetCells();
         score = 0;
         lines_cleared = 0;
         level_num = 1;
@@ -136,6 +243,7 @@ void Lost_Thread()
         blockY = START_Y;
         blockX = START_X;
 
+        // clears the board too
         renderCrosshatchGrid();
 
         randomiseGrabBag();
@@ -145,21 +253,11 @@ void Lost_Thread()
         hold_allowed = 1;
 
         G8RTOS_WriteFIFO(0, 0);
+        setScreen(SCREEN_PLAYING);
         resetting = 0;
         G8RTOS_SignalSemaphore(&sem_update_ui);
 
-        ST7789_DrawRectangle(FRAME_X_OFF - (5 * FONT_WIDTH) - 2 - FONT_WIDTH,
-        FRAME_Y_OFF + 9 * BLOCK_SIZE - 2,
-                             6 * FONT_WIDTH, FONT_WIDTH, 0);
-
-        ST7789_DrawRectangle(FRAME_X_OFF - (5 * FONT_WIDTH) - 2 - FONT_WIDTH,
-        FRAME_Y_OFF + 5 * BLOCK_SIZE - 2,
-                             6 * FONT_WIDTH, FONT_WIDTH, 0);
-
-        ST7789_DrawRectangle(FRAME_X_OFF - (5 * FONT_WIDTH) - 2 - FONT_WIDTH,
-        FRAME_Y_OFF + 1 * BLOCK_SIZE - 2,
-                             6 * FONT_WIDTH, FONT_WIDTH, 0);
-
+        DisplayList_Submit();
     }
 }
 
@@ -173,34 +271,22 @@ void FallingBlock_Thread()
     int8_t wallKick = 0;
     uint8_t curr, blockAtPos = 0;
 
-    uint16_t colors[NUM_SHAPES] = { 0xF800, 0x055F, 0x07E0, 0xF81F, 0x001F, 0x07FF, 0xFFE0 };
-
-    ST7789_DrawOutline(FRAME_X_OFF - 1, FRAME_Y_OFF - 1, BLOCK_SIZE * COLS + 2,
-    BLOCK_SIZE * ROWS + 2,
-                       0xFFFF);
+    // piece movement is drawn before the board and score updates
+    DisplayList_SetLane(DISPLAYLIST_LANE_PIECE);
 
+    // draws the frame outline too
     renderCrosshatchGrid();
 
+    for (int8_t k = 0; k <= PREVIEW_COUNT; k++)
+    {
+        Compositor_Init(&previewSlots[k], PREVIEW_X(k) + 1, PREVIEW_Y(k) + 1, PREVIEW_W,
+                        PREVIEW_H, 0);
+    }
+
     randomiseGrabBag();
 
     curBlock = piece_grab_bag[curBlockInd];
 
-    // https://i.pinimg.com/736x/07/bf/d7/07bfd7e344183c428d841cf2813de97a.jpg
-    // 1x4 is 5, 2x2 is 6
-
-    // 3x3 grid (middle always filled)
-    // 0 1 2
-    // 3 F 4
-    // 5 6 7
-    unsigned char shapes[4][NUM_SHAPES] = { { 0b10011000, 0b00111000, 0b01110000, 0b01011000,
-                                              0b11001000, 0b00010110, 0b00011000 },
-                                            { 0b01100010, 0b01000011, 0b01001001, 0b01001010,
-                                              0b00101010, 0b00010110, 0b01000010 },
-                                            { 0b00011001, 0b00011100, 0b00001110, 0b00011010,
-                                              0b00010011, 0b00010110, 0b00011000 },
-                                            { 0b01000110, 0b11000010, 0b10010010, 0b01010010,
-                                              0b01010100, 0b00010110, 0b01000010 } };
-
     G8RTOS_Add_PeriodicEvent(Gravity_P, (uint32_t) START_SPEED, 50, GRAVITY_THREAD_ID);
 
     if (level_num != 1)
@@ -222,52 +308,66 @@ void FallingBlock_Thread()
         if (resetting)
             continue;
 
+        if (move == MOVE_PAUSE)
+        {
+            setScreen(screen == SCREEN_PAUSED ? SCREEN_PLAYING : SCREEN_PAUSED);
+            DisplayList_Submit();
+            continue;
+        }
+
+        // only player moves are dropped while paused, the MOVE_NONE queued
+        // after a piece lands or is swapped still spawns the next one
+        if (screen == SCREEN_PAUSED && move != MOVE_NONE)
+            continue;
+
         instaDrop = 0;
         moveValid = 0;
         wallKick = 0;
 
-        // clear shadow
+        // clear shadow, unless the piece is drawn over it
         if (move != MOVE_DOWN && shadowX[0] != -1)
         {
             for (int8_t j = 0; j < 4; j++)
             {
-                ST7789_DrawRectangle(
-                FRAME_X_OFF + shadowX[j] * BLOCK_SIZE + 1,
-                                     FRAME_Y_OFF + shadowY[j] * BLOCK_SIZE + 1,
-                                     BLOCK_SIZE - 2,
-                                     BLOCK_SIZE - 2, 0);
+                if (CELL_IS_SHADOW(getCell(shadowX[j], shadowY[j])))
+                    setCell(shadowX[j], shadowY[j], CELL_EMPTY);
             }
         }
 
         if (move == MOVE_NONE)
         {
             // rendering for held piece and lookahead preview
-            int8_t yOffset = -1;
-            int8_t xOffset = -1;
             uint8_t pieceOffset = 0;
             uint8_t previewBlock;
+            uint16_t slotX, slotY;
 
             for (int8_t k = 0; k <= PREVIEW_COUNT; k++)
             {
+                compositor_t *slot = &previewSlots[k];
+
                 // when k == 0, we are rendering the held piece
                 if (k == 0)
                 {
                     previewBlock = heldBlock;
-                    xOffset = -(COLS + 5);
                 }
                 else
                 {
                     pieceOffset++;
                     previewBlock = piece_grab_bag[(curBlockInd + pieceOffset) % NUM_SHAPES];
                 }
-                yOffset += 5;
+                slotX = PREVIEW_X(k);
+                slotY = PREVIEW_Y(k);
 
-                curr = 0;
-                for (int8_t j = 2; j >= 0; j--)
+                // the slot background is black, only the blocks are added
+                Compositor_Clear(slot);
+
+                // nothing held yet
+                if (previewBlock < NUM_SHAPES)
                 {
-                    for (int8_t i = 0; i < 3; i++)
+                    curr = 0;
+                    for (int8_t j = 2; j >= 0; j--)
                     {
-                        if (!resetting)
+                        for (int8_t i = 0; i < 3; i++)
                         {
                             if (i == 1 && j == 1)
                             {
@@ -282,52 +382,27 @@ void FallingBlock_Thread()
 
                             if (blockAtPos)
                             {
-                                ST7789_DrawRectangle(
-                                        FRAME_X_OFF + (COLS + 1 + i + xOffset) * BLOCK_SIZE + 1
+                                Compositor_Rect(
+                                        slot,
+                                        slotX + i * BLOCK_SIZE + 1
                                                 + (previewBlock == LINE ? BLOCK_SIZE / 2 : 0),
-                                        FRAME_Y_OFF + (ROWS - yOffset + j) * BLOCK_SIZE + 1,
+                                        slotY + j * BLOCK_SIZE + 1,
                                         BLOCK_SIZE - 2,
-                                        BLOCK_SIZE - 2, colors[previewBlock]);
-                            }
-                            else
-                            {
-                                ST7789_DrawRectangle(
-                                        FRAME_X_OFF + (COLS + 1 + i + xOffset) * BLOCK_SIZE + 1
-                                                + ((previewBlock == LINE && i == 2) ?
-                                                        (BLOCK_SIZE / 2) - 2 : 0),
-                                        FRAME_Y_OFF + (ROWS - yOffset + j) * BLOCK_SIZE + 1,
-                                        BLOCK_SIZE + ((previewBlock == LINE) ? BLOCK_SIZE / 2 : 0),
-                                        BLOCK_SIZE, 0);
+                                        BLOCK_SIZE - 2, pieceColors[previewBlock]);
                             }
                         }
                     }
+                    if (previewBlock == LINE)
+                    {
+                        Compositor_Rect(slot, slotX + BLOCK_SIZE + 1 + BLOCK_SIZE / 2,
+                                        slotY + 3 * BLOCK_SIZE + 1,
+                                        BLOCK_SIZE - 2,
+                                        BLOCK_SIZE - 2, pieceColors[previewBlock]);
+                    }
                 }
-                if (previewBlock == LINE)
-                {
-                    ST7789_DrawRectangle(
-                    FRAME_X_OFF + (COLS + 2 + xOffset) * BLOCK_SIZE + 1 + BLOCK_SIZE / 2,
-                                         FRAME_Y_OFF + (ROWS - yOffset + 3) * BLOCK_SIZE + 1,
-                                         BLOCK_SIZE - 2,
-                                         BLOCK_SIZE - 2, colors[previewBlock]);
-                }
-                else
-                {
-                    ST7789_DrawRectangle(
-                    FRAME_X_OFF + (COLS + 2 + xOffset) * BLOCK_SIZE + 1 + BLOCK_SIZE / 2,
-                                         FRAME_Y_OFF + (ROWS - yOffset + 3) * BLOCK_SIZE + 1,
-                                         BLOCK_SIZE - 2,
-                                         BLOCK_SIZE - 2, 0);
-                    ST7789_DrawRectangle(
-                    FRAME_X_OFF + (COLS + 3 + xOffset) * BLOCK_SIZE + -1,
-                                         FRAME_Y_OFF + (ROWS - yOffset) * BLOCK_SIZE + 1, 2,
-                                         BLOCK_SIZE * 4,
-                                         0);
-                }
-                if (k == 0)
-                {
-                    yOffset = -1;
-                    xOffset = -1;
-                }
+
+                if (!resetting)
+                    Compositor_Submit(slot);
             }
 
             // piece offset override on spawn
@@ -495,12 +570,7 @@ void FallingBlock_Thread()
 
                         if (blockAtPos)
                         {
-                            ST7789_DrawRectangle(
-                            FRAME_X_OFF + (blockX + i) * BLOCK_SIZE + 1,
-                                                 FRAME_Y_OFF + (blockY + j) * BLOCK_SIZE + 1,
-                                                 BLOCK_SIZE - 2,
-                                                 BLOCK_SIZE - 2,
-                                                 GRAY);
+                            setCell(blockX + i, blockY + j, CELL_STATIC);
                             setStaticBlockBit(blockX + i, blockY + j, 1, 1);
                         }
                     }
@@ -510,16 +580,12 @@ void FallingBlock_Thread()
                 {
                     if (ROT_VERTICAL)
                     {
-                        ST7789_DrawRectangle(FRAME_X_OFF + (blockX + 1) * BLOCK_SIZE + 1,
-                        FRAME_Y_OFF + (blockY + 3) * BLOCK_SIZE + 1,
-                                             BLOCK_SIZE - 2, BLOCK_SIZE - 2, GRAY);
+                        setCell(blockX + 1, blockY + 3, CELL_STATIC);
                         setStaticBlockBit(blockX + 1, blockY + 3, 1, 1);
                     }
                     else
                     {
-                        ST7789_DrawRectangle(FRAME_X_OFF + (blockX + 3) * BLOCK_SIZE + 1,
-                        FRAME_Y_OFF + (blockY + 1) * BLOCK_SIZE + 1,
-                                             BLOCK_SIZE - 2, BLOCK_SIZE - 2, GRAY);
+                        setCell(blockX + 3, blockY + 1, CELL_STATIC);
                         setStaticBlockBit(blockX + 3, blockY + 1, 1, 1);
                     }
                 }
@@ -752,11 +818,7 @@ void FallingBlock_Thread()
 
                         if (blockAtPos)
                         {
-                            ST7789_DrawRectangle(
-                            FRAME_X_OFF + (blockX + i) * BLOCK_SIZE + 1,
-                                                 FRAME_Y_OFF + (blockY + j) * BLOCK_SIZE + 1,
-                                                 BLOCK_SIZE - 2,
-                                                 BLOCK_SIZE - 2, 0);
+                            setCell(blockX + i, blockY + j, CELL_EMPTY);
                         }
                     }
                 }
@@ -764,15 +826,11 @@ void FallingBlock_Thread()
                 {
                     if (ROT_VERTICAL)
                     {
-                        ST7789_DrawRectangle(FRAME_X_OFF + (blockX + 1) * BLOCK_SIZE + 1,
-                        FRAME_Y_OFF + (blockY + 3) * BLOCK_SIZE + 1,
-                                             BLOCK_SIZE - 2, BLOCK_SIZE - 2, 0);
+                        setCell(blockX + 1, blockY + 3, CELL_EMPTY);
                     }
                     else
                     {
-                        ST7789_DrawRectangle(FRAME_X_OFF + (blockX + 3) * BLOCK_SIZE + 1,
-                        FRAME_Y_OFF + (blockY + 1) * BLOCK_SIZE + 1,
-                                             BLOCK_SIZE - 2, BLOCK_SIZE - 2, 0);
+                        setCell(blockX + 3, blockY + 1, CELL_EMPTY);
                     }
                 }
             }
@@ -879,7 +937,11 @@ void FallingBlock_Thread()
 
             if (resetting)
             {
-                G8RTOS_SignalSemaphore(&sem_lost);
+                // Lost_Thread resets the board once the game over pause is up
+                G8RTOS_StartTimer(lost_timer);
+                flushCells();
+                setScreen(SCREEN_GAME_OVER);
+                DisplayList_Submit();
                 continue;
             }
 
@@ -902,11 +964,7 @@ void FallingBlock_Thread()
 
                     if (blockAtPos)
                     {
-                        ST7789_DrawRectangle(
-                        FRAME_X_OFF + (blockX + i) * BLOCK_SIZE + 1,
-                                             FRAME_Y_OFF + (blockY + j) * BLOCK_SIZE + 1,
-                                             BLOCK_SIZE - 2,
-                                             BLOCK_SIZE - 2, colors[curBlock]);
+                        setCell(blockX + i, blockY + j, CELL_PIECE(curBlock));
                     }
                 }
             }
@@ -914,15 +972,11 @@ void FallingBlock_Thread()
             {
                 if (ROT_VERTICAL)
                 {
-                    ST7789_DrawRectangle(FRAME_X_OFF + (blockX + 1) * BLOCK_SIZE + 1,
-                    FRAME_Y_OFF + (blockY + 3) * BLOCK_SIZE + 1,
-                                         BLOCK_SIZE - 2, BLOCK_SIZE - 2, colors[curBlock]);
+                    setCell(blockX + 1, blockY + 3, CELL_PIECE(curBlock));
                 }
                 else
                 {
-                    ST7789_DrawRectangle(FRAME_X_OFF + (blockX + 3) * BLOCK_SIZE + 1,
-                    FRAME_Y_OFF + (blockY + 1) * BLOCK_SIZE + 1,
-                                         BLOCK_SIZE - 2, BLOCK_SIZE - 2, colors[curBlock]);
+                    setCell(blockX + 3, blockY + 1, CELL_PIECE(curBlock));
                 }
 
             }
@@ -973,56 +1027,7 @@ void FallingBlock_Thread()
         else
         {
             // find y offset for shadow
-            uint8_t previewOffset = 1;
-            uint8_t done = 0;
-            while (!done)
-            {
-                curr = 0;
-                for (int8_t j = 2; j >= 0; j--)
-                {
-                    for (int8_t i = 0; i < 3; i++)
-                    {
-                        if (i == 1 && j == 1)
-                        {
-                            blockAtPos = 1;
-                        }
-                        else
-                        {
-                            blockAtPos = shapes[(blockRotation - 1) % 4][curBlock] >> (7 - curr)
-                                    & 1;
-                            curr++;
-                        }
-
-                        if (blockAtPos)
-                        {
-                            if (getStaticBlockBit(blockX + i, blockY + j - previewOffset))
-                            {
-                                done = 1;
-
-                            }
-                        }
-                    }
-                }
-                if (curBlock == LINE)
-                {
-                    if (ROT_VERTICAL)
-                    {
-                        if (getStaticBlockBit(blockX + 1, blockY + 3 - previewOffset))
-                        {
-                            done = 1;
-                        }
-                    }
-                    else
-                    {
-                        if (getStaticBlockBit(blockX + 3, blockY + 1 - previewOffset))
-                        {
-                            done = 1;
-                        }
-                    }
-                }
-                previewOffset++;
-            }
-            previewOffset -= 2;
+            uint8_t previewOffset = blockY - shadowRow();
 
             // render shadow
             uint8_t shadowIndex = 0;
@@ -1047,12 +1052,7 @@ void FallingBlock_Thread()
                     {
                         shadowX[shadowIndex] = blockX + i;
                         shadowY[shadowIndex++] = blockY + j - previewOffset;
-                        ST7789_DrawOutline(
-                                FRAME_X_OFF + (blockX + i) * BLOCK_SIZE + 1,
-                                FRAME_Y_OFF + (blockY + j - previewOffset) * BLOCK_SIZE + 1,
-                                BLOCK_SIZE - 2,
-                                BLOCK_SIZE - 2,
-                                SHADOW_COLOR);
+                        setShadowCell(blockX + i, blockY + j - previewOffset);
                     }
 
                 }
@@ -1062,32 +1062,30 @@ void FallingBlock_Thread()
                 if (ROT_VERTICAL)
                 {
 
-                    ST7789_DrawOutline(FRAME_X_OFF + (blockX + 1) * BLOCK_SIZE + 1,
-                    FRAME_Y_OFF + (blockY + 3 - previewOffset) * BLOCK_SIZE + 1,
-                                       BLOCK_SIZE - 2, BLOCK_SIZE - 2, SHADOW_COLOR);
+                    setShadowCell(blockX + 1, blockY + 3 - previewOffset);
                     shadowX[shadowIndex] = blockX + 1;
                     shadowY[shadowIndex] = blockY + 3 - previewOffset;
 
                 }
                 else
                 {
-                    ST7789_DrawOutline(FRAME_X_OFF + (blockX + 3) * BLOCK_SIZE + 1,
-                            FRAME_Y_OFF + (blockY + 1 - previewOffset) * BLOCK_SIZE + 1,
-                            BLOCK_SIZE - 2, BLOCK_SIZE - 2, SHADOW_COLOR);
+                    setShadowCell(blockX + 3, blockY + 1 - previewOffset);
                     shadowX[shadowIndex] = blockX + 3;
                     shadowY[shadowIndex] = blockY + 1 - previewOffset;
                 }
             }
         }
 
+        flushCells();
+        DisplayList_Submit();
         G8RTOS_Yield();
     }
 }
 
 void StaticBlocks_Thread()
 {
-    int8_t i, j, numCleared, prevNumCleared = 0;
-    uint8_t old, shifted, prevLevelNum;
+    int8_t i, numCleared, prevNumCleared = 0;
+    uint8_t prevLevelNum;
 
     while (true)
     {
@@ -1105,13 +1103,6 @@ void StaticBlocks_Thread()
 
             if (staticCheckClear(i))
             {
-                if (!numCleared)
-                {
-                    for (j = 0; j < BLOCKS_ARRAY_SIZE; j++)
-                    {
-                        old_static_blocks[j] = static_blocks[j];
-                    }
-                }
                 numCleared++;
                 lines_cleared++;
                 slideStaticBlocks(i);
@@ -1157,109 +1148,58 @@ void StaticBlocks_Thread()
             }
         }
 
-        // shift down the static blocks
-        for (++i; i < ROWS - numCleared; i++)
-        {
-            for (j = 0; j < COLS; j++)
-            {
-                // shift staticBlocksArr
-                old = getOldStaticBlockBit(j, i);
-                shifted = getStaticBlockBit(j, i);
-
-                // render changes in static blocks
-                if (!shifted && old)
-                    ST7789_DrawRectangle(FRAME_X_OFF + j * BLOCK_SIZE + 1,
-                    FRAME_Y_OFF + i * BLOCK_SIZE + 1,
-                                         BLOCK_SIZE - 2, BLOCK_SIZE - 2, 0);
-                else if (shifted && !old)
-                    ST7789_DrawRectangle(FRAME_X_OFF + j * BLOCK_SIZE + 1,
-                    FRAME_Y_OFF + i * BLOCK_SIZE + 1,
-                                         BLOCK_SIZE - 2, BLOCK_SIZE - 2, GRAY);
-            }
-        }
+        // redraw the cells the slide changed
+        syncStaticCells();
+#ifdef BOARD_SCROLL_LAYOUT
+        scrollCells(numCleared);
+#endif
+        flushCells();
 
-        // clear the top rows
-        for (i = ROWS - 1; i <= ROWS - numCleared; i++)
-        {
-            for (j = 0; j < COLS; j++)
-            {
-                if (getStaticBlockBit(j, i))
-                    ST7789_DrawRectangle(FRAME_X_OFF + j * BLOCK_SIZE + 1,
-                    FRAME_Y_OFF + i * BLOCK_SIZE + 1,
-                                         BLOCK_SIZE - 2, BLOCK_SIZE - 2, 0);
-            }
-        }
+        DisplayList_Submit();
     }
 }
 
 uint8_t is_dead = 0;
 
+// draws UI text centered over a 5 character label starting at column, but
+// no further left than the number under it
+void drawUIText(const char *text, int16_t column, uint16_t y)
+{
+    int16_t x = column + (5 * FONT_WIDTH) / 2
+            - ST7789_GetTextWidth(&FontStyle_Emulogic, text) / 2;
+
+    if (x < column - FONT_WIDTH)
+        x = column - FONT_WIDTH;
+
+    DisplayList_Text(&FontStyle_Emulogic, text, x, y, ST7789_WHITE, ST7789_BLACK);
+}
+
 void DrawUI_Thread()
 {
-    char title[6];
-    char numstr[4];
-
-    sprintf(title, "HIGH");
-    ST7789_DrawText(&FontStyle_Emulogic, (const char*) &title,
-    FRAME_X_OFF - (5 * FONT_WIDTH) - 2 + FONT_WIDTH / 2,
-                    FRAME_Y_OFF + 10 * BLOCK_SIZE,
-                    ST7789_WHITE,
-                    ST7789_BLACK);
-
-    sprintf(title, "SCORE");
-    ST7789_DrawText(&FontStyle_Emulogic, (const char*) &title,
-    FRAME_X_OFF - (5 * FONT_WIDTH) - 2,
-                    FRAME_Y_OFF + 6 * BLOCK_SIZE,
-                    ST7789_WHITE,
-                    ST7789_BLACK);
-
-    sprintf(title, "LEVEL");
-    ST7789_DrawText(&FontStyle_Emulogic, (const char*) &title,
-    FRAME_X_OFF - (5 * FONT_WIDTH) - 2,
-                    FRAME_Y_OFF + 2 * BLOCK_SIZE,
-                    ST7789_WHITE,
-                    ST7789_BLACK);
+    static numField_t highField, scoreField, levelField;
+
+    DisplayList_SetLane(DISPLAYLIST_LANE_UI);
+
+    drawUIText("HIGH", UI_HIGH_X, UI_HIGH_Y);
+    drawUIText("SCORE", UI_SCORE_X, UI_SCORE_Y);
+    drawUIText("LEVEL", UI_LEVEL_X, UI_LEVEL_Y);
+
+    NumField_Init(&highField, &FontStyle_Emulogic, UI_NUM_RIGHT(UI_HIGH_X),
+                  UI_HIGH_Y - UI_NUM_OFF, UI_NUM_DIGITS, ST7789_WHITE, ST7789_BLACK);
+    NumField_Init(&scoreField, &FontStyle_Emulogic, UI_NUM_RIGHT(UI_SCORE_X),
+                  UI_SCORE_Y - UI_NUM_OFF, UI_NUM_DIGITS, ST7789_WHITE, ST7789_BLACK);
+    NumField_Init(&levelField, &FontStyle_Emulogic, UI_NUM_RIGHT(UI_LEVEL_X),
+                  UI_LEVEL_Y - UI_NUM_OFF, UI_NUM_DIGITS, ST7789_WHITE, ST7789_BLACK);
 
     while (true)
     {
         G8RTOS_WaitSemaphore(&sem_update_ui);
 
-        sprintf(numstr, "%u", highscore);
-        ST7789_DrawText(
-                &FontStyle_Emulogic,
-                (const char*) &numstr,
-                FRAME_X_OFF - (5 * FONT_WIDTH) - 2 + FONT_WIDTH * 2
-                        - (highscore > 9 ? FONT_WIDTH / 2 : 0)
-                        - (highscore > 99 ? FONT_WIDTH / 2 : 0)
-                        - (highscore > 999 ? FONT_WIDTH / 2 : 0)
-                        - (highscore > 9999 ? FONT_WIDTH / 2 : 0)
-                        - (highscore > 99999 ? FONT_WIDTH : 0),
-                FRAME_Y_OFF + 9 * BLOCK_SIZE - 2,
-                ST7789_WHITE,
-                ST7789_BLACK);
-
-        sprintf(numstr, "%u", score);
-        ST7789_DrawText(
-                &FontStyle_Emulogic,
-                (const char*) &numstr,
-                FRAME_X_OFF - (5 * FONT_WIDTH) - 2 + FONT_WIDTH * 2
-                        - (score > 9 ? FONT_WIDTH / 2 : 0) - (score > 99 ? FONT_WIDTH / 2 : 0)
-                        - (score > 999 ? FONT_WIDTH / 2 : 0) - (score > 9999 ? FONT_WIDTH / 2 : 0)
-                        - (score > 99999 ? FONT_WIDTH : 0),
-                FRAME_Y_OFF + 5 * BLOCK_SIZE - 2,
-                ST7789_WHITE,
-                ST7789_BLACK);
-
-        sprintf(numstr, "%u", level_num);
-        ST7789_DrawText(
-                &FontStyle_Emulogic,
-                (const char*) &numstr,
-                FRAME_X_OFF - (5 * FONT_WIDTH)
-                        + (level_num > 9 ? FONT_WIDTH + FONT_WIDTH / 2 : FONT_WIDTH * 2) - 2,
-                FRAME_Y_OFF + 1 * BLOCK_SIZE - 2,
-                ST7789_WHITE,
-                ST7789_BLACK);
+        NumField_Set(&highField, highscore);
+        NumField_Set(&scoreField, score);
+        NumField_Set(&levelField, level_num);
 
+        DisplayList_Submit();
         G8RTOS_Yield();
     }
 }
@@ -1268,6 +1208,7 @@ uint16_t joy_released = 1;
 uint16_t rotate_released = 1;
 uint16_t drop_released = 1;
 uint16_t hold_released = 1;
+uint16_t pause_released = 1;
 uint8_t joy_i = 0;
 
 void Get_Input_P()
@@ -1298,7 +1239,8 @@ void Get_Input_P()
     {
         G8RTOS_WriteFIFO(0, 3);
         joy_released = 0;
-        score += 1;
+        if (screen == SCREEN_PLAYING)
+            score += 1;
     }
 
     uint8_t buttons = MultimodButtons_Get();
@@ -1344,13 +1286,31 @@ void Get_Input_P()
         hold_released = true;
     }
 
+    if (buttons & 16)
+    {
+        if (pause_released)
+        {
+            G8RTOS_WriteFIFO(0, MOVE_PAUSE);
+            pause_released = false;
+        }
+    }
+    else
+    {
+        pause_released = true;
+    }
+
     G8RTOS_Yield();
 
 }
 
+void Lost_Timer()
+{
+    G8RTOS_SignalSemaphore(&sem_lost);
+}
+
 void Gravity_P()
 {
-    if (!resetting)
+    if (!resetting && screen != SCREEN_PAUSED)
     {
         G8RTOS_WriteFIFO(0, MOVE_DOWN);
         timer++;
@@ -1401,6 +1361,7 @@ void setStaticBlockBit(int8_t col, int8_t row, int8_t value, uint8_t canLose)
     {
         static_blocks[byteIndex] &= ~(1 << bitInByte);
     }
+    static_gen++;
 }
 
 uint8_t getStaticBlockBit(int8_t col, int8_t row)
@@ -1416,17 +1377,120 @@ uint8_t getStaticBlockBit(int8_t col, int8_t row)
     return (static_blocks[byteIndex] >> bitInByte) & 1;
 }
 
-uint8_t getOldStaticBlockBit(int8_t col, int8_t row)
+// a piece with its 3x3 grid at col, row overlaps static blocks or the
+// board edges
+uint8_t pieceCollides(uint8_t piece, uint8_t rotation, int8_t col, int8_t row)
 {
-    if (row < 0 || row >= ROWS || col < 0 || col >= COLS)
+    uint8_t curr = 0;
+
+    for (int8_t j = 2; j >= 0; j--)
     {
-        return 1;
+        for (int8_t i = 0; i < 3; i++)
+        {
+            uint8_t blockAtPos;
+
+            if (i == 1 && j == 1)
+            {
+                blockAtPos = 1;
+            }
+            else
+            {
+                blockAtPos = shapes[(rotation - 1) % 4][piece] >> (7 - curr) & 1;
+                curr++;
+            }
+
+            if (blockAtPos && getStaticBlockBit(col + i, row + j))
+                return 1;
+        }
+    }
+
+    if (piece == LINE)
+    {
+        if ((rotation - 1) % 2)
+            return getStaticBlockBit(col + 1, row + 3);
+        else
+            return getStaticBlockBit(col + 3, row + 1);
     }
-    int bitIndex = row * COLS + col;
-    int byteIndex = bitIndex / BITS_PER_BYTE;
-    int bitInByte = bitIndex % BITS_PER_BYTE;
 
-    return (old_static_blocks[byteIndex] >> bitInByte) & 1;
+    return 0;
+}
+
+// row a piece comes to rest at, dropped straight down from row
+int8_t findShadowRow(uint8_t piece, uint8_t rotation, int8_t col, int8_t row)
+{
+    // the floor stops every piece
+    while (!pieceCollides(piece, rotation, col, row - 1))
+    {
+        row--;
+    }
+
+    return row;
+}
+
+// row the current piece's shadow goes on, taken from shadow_table when the
+// idle hook got to it first
+int8_t shadowRow()
+{
+    int8_t x = blockX - SHADOW_X_MIN;
+    uint8_t r = (blockRotation - 1) % 4;
+
+    if (shadow_table_piece == curBlock && shadow_table_gen == static_gen && blockY <= shadow_table_y
+            && x >= 0 && x < SHADOW_COLS && (shadow_valid >> (r * SHADOW_COLS + x) & 1)
+            && shadow_table[r][x] <= blockY)
+    {
+        return shadow_table[r][x];
+    }
+
+    return findShadowRow(curBlock, blockRotation, blockX, blockY);
+}
+
+// shadowIdleHook
+// Idle hook, works out one shadow_table entry per call for the current
+// piece. The table starts over once the piece changes, moves up (a new
+// piece) or static_blocks changes.
+// Return: bool, true while entries are left
+bool shadowIdleHook()
+{
+    int32_t BasePri_State = StartKernelCriticalSection();
+
+    uint8_t piece = curBlock;
+    uint32_t gen = static_gen;
+
+    if (piece != shadow_table_piece || gen != shadow_table_gen || blockY > shadow_table_y)
+    {
+        shadow_table_piece = piece;
+        shadow_table_gen = gen;
+        shadow_table_y = blockY;
+        shadow_valid = 0;
+        shadow_next = 0;
+    }
+
+    uint8_t entry = shadow_next;
+    int8_t y = shadow_table_y;
+
+    EndKernelCriticalSection(BasePri_State);
+
+    if (entry >= 4 * SHADOW_COLS)
+        return false;
+
+    // threads can run while this works, static_blocks is only read
+    int8_t row = findShadowRow(piece, entry / SHADOW_COLS + 1, entry % SHADOW_COLS + SHADOW_X_MIN,
+                               y);
+
+    BasePri_State = StartKernelCriticalSection();
+
+    // dropped if the table started over in the meantime
+    if (static_gen == gen && shadow_table_gen == gen && shadow_table_piece == piece
+            && shadow_table_y == y && shadow_next == entry)
+    {
+        shadow_table[entry / SHADOW_COLS][entry % SHADOW_COLS] = row;
+        shadow_valid |= (uint64_t) 1 << entry;
+        shadow_next++;
+    }
+
+    EndKernelCriticalSection(BasePri_State);
+
+    return true;
 }
 
 void slideStaticBlocks(int8_t row)
@@ -1491,28 +1555,182 @@ void randomiseGrabBag()
     }
 }
 
+// frame, crosshatch grid and empty cells of the board, painted by a single
+// pattern fill
 void renderCrosshatchGrid()
 {
-    for (uint8_t i = 1; i < COLS; i++)
+    DisplayList_Pattern(GRID_X, GRID_Y, GRID_W, GRID_H, BoardGrid_Pattern());
+}
+
+// records the panel mode change of moving to a display state, the board is
+// drawn the same in every state
+void setScreen(uint8_t next)
+{
+    static const uint8_t modes[] = { ST7789_MODE_NORMAL, ST7789_MODE_PARTIAL_IDLE,
+                                     ST7789_MODE_PARTIAL };
+
+    if (next == screen)
     {
-        ST7789_DrawLine(FRAME_X_OFF + BLOCK_SIZE * i, FRAME_Y_OFF,
-        FRAME_X_OFF + BLOCK_SIZE * i,
-                        FRAME_Y_OFF + BLOCK_SIZE * ROWS - 1, DARK_GRAY);
-        ST7789_DrawLine(FRAME_X_OFF + BLOCK_SIZE * i - 1, FRAME_Y_OFF,
-        FRAME_X_OFF + BLOCK_SIZE * i - 1,
-                        FRAME_Y_OFF + BLOCK_SIZE * ROWS - 1, DARK_GRAY);
+        return;
     }
 
-    for (uint8_t i = 1; i < ROWS; i++)
+    screen = next;
+    DisplayList_Mode(modes[next], SCREEN_PARTIAL_TOP, SCREEN_PARTIAL_HEIGHT);
+}
+
+uint8_t getCell(int8_t col, int8_t row)
+{
+    if (row < 0 || row >= ROWS || col < 0 || col >= COLS)
     {
-        ST7789_DrawLine(FRAME_X_OFF, FRAME_Y_OFF + BLOCK_SIZE * i,
-        FRAME_X_OFF + BLOCK_SIZE * COLS - 1,
-                        FRAME_Y_OFF + BLOCK_SIZE * i, DARK_GRAY);
+        return CELL_EMPTY;
+    }
+
+    return cells[row * COLS + col];
+}
 
-        ST7789_DrawLine(FRAME_X_OFF, FRAME_Y_OFF + BLOCK_SIZE * i - 1,
-        FRAME_X_OFF + BLOCK_SIZE * COLS - 1,
-                        FRAME_Y_OFF + BLOCK_SIZE * i - 1, DARK_GRAY);
+// cells outside the board are not drawn
+void setCell(int8_t col, int8_t row, uint8_t state)
+{
+    if (row < 0 || row >= ROWS || col < 0 || col >= COLS)
+    {
+        return;
+    }
+    int cellIndex = row * COLS + col;
+
+    G8RTOS_WaitSemaphore(&sem_cells);
+    cells[cellIndex] = state;
+    dirty_cells[cellIndex / BITS_PER_BYTE] |= 1 << (cellIndex % BITS_PER_BYTE);
+    G8RTOS_SignalSemaphore(&sem_cells);
+}
+
+// shadow of the current piece, only over empty cells
+void setShadowCell(int8_t col, int8_t row)
+{
+    uint8_t state = getCell(col, row);
+
+    if (state == CELL_EMPTY || CELL_IS_SHADOW(state))
+    {
+        setCell(col, row, CELL_SHADOW(curBlock));
+    }
+}
+
+// makes the static cells match static_blocks, leaving the falling piece alone
+void syncStaticCells()
+{
+    for (int8_t row = 0; row < ROWS; row++)
+    {
+        for (int8_t col = 0; col < COLS; col++)
+        {
+            uint8_t state = getCell(col, row);
+
+            if (getStaticBlockBit(col, row))
+            {
+                if (state != CELL_STATIC)
+                    setCell(col, row, CELL_STATIC);
+            }
+            else if (state == CELL_STATIC)
+            {
+                setCell(col, row, CELL_EMPTY);
+            }
+        }
+    }
+}
+
+// board has been cleared on screen
+void resetCells()
+{
+    G8RTOS_WaitSemaphore(&sem_cells);
+    for (uint8_t i = 0; i < ROWS * COLS; i++)
+    {
+        cells[i] = CELL_EMPTY;
+        drawn_cells[i] = CELL_EMPTY;
+    }
+    for (uint8_t i = 0; i < BLOCKS_ARRAY_SIZE; i++)
+    {
+        dirty_cells[i] = 0;
+    }
+    G8RTOS_SignalSemaphore(&sem_cells);
+}
+
+#ifdef BOARD_SCROLL_LAYOUT
+// shifts the board down by rows with hardware scrolling, if that leaves
+// fewer cells to redraw than drawing the changes in place
+void scrollCells(uint8_t rows)
+{
+    uint8_t shifted[ROWS * COLS];
+    uint8_t inPlace = 0, scrolled = 0;
+
+    G8RTOS_WaitSemaphore(&sem_cells);
+    for (uint8_t i = 0; i < ROWS * COLS; i++)
+    {
+        shifted[i] = drawn_cells[(i + rows * COLS) % (ROWS * COLS)];
+        inPlace += cells[i] != drawn_cells[i];
+        scrolled += cells[i] != shifted[i];
+    }
+
+    if (scrolled < inPlace)
+    {
+        for (uint8_t i = 0; i < ROWS * COLS; i++)
+        {
+            drawn_cells[i] = shifted[i];
+        }
+        for (uint8_t i = 0; i < BLOCKS_ARRAY_SIZE; i++)
+        {
+            dirty_cells[i] = 0xFF;
+        }
+
+        board_scroll = (board_scroll + rows) % ROWS;
+        DisplayList_Scroll(FRAME_Y_OFF, BLOCK_SIZE * ROWS,
+                           FRAME_Y_OFF + board_scroll * BLOCK_SIZE);
+    }
+    G8RTOS_SignalSemaphore(&sem_cells);
+}
+#endif
+
+// records the dirty cells whose state changed since they were last drawn
+void flushCells()
+{
+    G8RTOS_WaitSemaphore(&sem_cells);
+    for (uint8_t byteIndex = 0; byteIndex < BLOCKS_ARRAY_SIZE; byteIndex++)
+    {
+        if (!dirty_cells[byteIndex])
+            continue;
+
+        for (uint8_t bitInByte = 0; bitInByte < BITS_PER_BYTE; bitInByte++)
+        {
+            uint8_t cellIndex = byteIndex * BITS_PER_BYTE + bitInByte;
+
+            if (!(dirty_cells[byteIndex] >> bitInByte & 1))
+                continue;
+
+            uint8_t state = cells[cellIndex];
+            uint8_t prev = drawn_cells[cellIndex];
+            uint16_t x = FRAME_X_OFF + (cellIndex % COLS) * BLOCK_SIZE + 1;
+            uint16_t y = FRAME_Y_OFF + ((cellIndex / COLS + board_scroll) % ROWS) * BLOCK_SIZE
+                    + 1;
+
+            if (state == prev)
+                continue;
+
+            if (CELL_IS_SHADOW(state))
+            {
+                if (prev != CELL_EMPTY)
+                    DisplayList_Rect(x, y, BLOCK_SIZE - 2, BLOCK_SIZE - 2, 0);
+                DisplayList_Outline(x, y, BLOCK_SIZE - 2, BLOCK_SIZE - 2,
+                                    pieceColors[state - CELL_SHADOW(0)]);
+            }
+            else
+            {
+                DisplayList_Rect(
+                        x, y, BLOCK_SIZE - 2, BLOCK_SIZE - 2,
+                        state == CELL_EMPTY ? 0 :
+                        state == CELL_STATIC ? GRAY : pieceColors[state - CELL_PIECE(0)]);
+            }
+            drawn_cells[cellIndex] = state;
+        }
+        dirty_cells[byteIndex] = 0;
     }
+    G8RTOS_SignalSemaphore(&sem_cells);
 }
 
 /********************************Public Functions***********************************/
@@ -9,6 +9,7 @@
 /************************************Includes***************************************/
 
 #include "./G8RTOS/G8RTOS_Semaphores.h"
+#include "./G8RTOS/G8RTOS_Timers.h"
 
 /************************************Includes***************************************/
 /***********************************Semaphores**************************************/
@@ -18,9 +19,18 @@ semaphore_t sem_gameEnd;
 semaphore_t sem_clearLine;
 semaphore_t sem_lost;
 semaphore_t sem_update_ui;
+// guards the board cell buffer
+semaphore_t sem_cells;
 
 /***********************************Semaphores**************************************/
 
+/*************************************Timers****************************************/
+
+// delay between topping out and the board reset
+timerID_t lost_timer;
+
+/*************************************Timers****************************************/
+
 /********************************Thread Functions***********************************/
 
 void Idle_Thread(void);
@@ -29,16 +39,31 @@ void FallingBlock_Thread();
 void StaticBlocks_Thread();
 void DrawUI_Thread();
 void Lost_Thread();
+void Render_Thread();
 
 void Gravity_P();
 void Get_Input_P();
 
+void Lost_Timer();
+
 void setStaticBlockBit(int8_t col, int8_t row, int8_t value, uint8_t canLose);
 uint8_t getStaticBlockBit(int8_t row, int8_t col);
 void renderCrosshatchGrid();
+void setScreen(uint8_t next);
+void drawUIText(const char *text, int16_t column, uint16_t y);
+uint8_t getCell(int8_t col, int8_t row);
+void setCell(int8_t col, int8_t row, uint8_t state);
+void setShadowCell(int8_t col, int8_t row);
+void syncStaticCells();
+void resetCells();
+void scrollCells(uint8_t rows);
+void flushCells();
 uint8_t staticCheckClear(int8_t row);
+uint8_t pieceCollides(uint8_t piece, uint8_t rotation, int8_t col, int8_t row);
+int8_t findShadowRow(uint8_t piece, uint8_t rotation, int8_t col, int8_t row);
+int8_t shadowRow();
+bool shadowIdleHook();
 void slideStaticBlocks(int8_t row);
-uint8_t getOldStaticBlockBit(int8_t col, int8_t row);
 void randomiseGrabBag();
 
 /********************************Thread Functions***********************************/
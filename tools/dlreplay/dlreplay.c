@@ -0,0 +1,289 @@
+// dlreplay.c
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-27
+// Host tool, replays display lists traced with DisplayList_SetTrace against
+// a software framebuffer. Every list is drawn both as recorded and after
+// DisplayList_Optimize and DisplayList_Prioritize, and the two framebuffers
+// are compared. Lists DisplayList_Prioritize changed the order of are
+// counted, which needs a trace that records lanes. The final frame is
+// written as a PPM.
+//
+// Build from the repository root:
+//   cc -std=c99 -DDISPLAYLIST_HOST -IMultimodDrivers -o dlreplay tools/dlreplay/dlreplay.c
+//      tools/dlreplay/dltrace.c MultimodDrivers/src/multimod_displaylist.c
+//      MultimodDrivers/src/fontlibrary.c
+//
+// Usage:
+//   dlreplay <trace.txt> [out.ppm]
+//
+// tools/dlreplay/sample_trace.txt is the trace the figures in the history
+// were measured on, a synthetic one written by sampletrace.py:
+//   dlreplay tools/dlreplay/sample_trace.txt
+// tools/dlreplay/lane_trace.txt is the same with mixed lanes, written by
+// sampletrace.py --lanes.
+
+/************************************Includes***************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "multimod_displaylist.h"
+#include "multimod_ST7789.h"
+#include "dltrace.h"
+
+/************************************Includes***************************************/
+
+/*******************************Private Variables***********************************/
+
+static uint16_t fbRecorded[Y_MAX][X_MAX];
+static uint16_t fbOptimized[Y_MAX][X_MAX];
+
+static displayOp_t recorded[DISPLAYLIST_MAX_OPS];
+static displayOp_t optimized[DISPLAYLIST_MAX_OPS];
+static displayOp_t unordered[DISPLAYLIST_MAX_OPS];
+
+// last vertical scroll, applied when writing the PPM
+static uint16_t scrollTop = 0, scrollHeight = Y_MAX, scrollStart = 0;
+
+// last display mode and partial area, applied when writing the PPM
+static uint8_t mode = ST7789_MODE_NORMAL;
+static uint16_t partialTop = 0, partialHeight = Y_MAX;
+
+/*******************************Private Variables***********************************/
+
+/********************************Private Functions**********************************/
+
+// SetPixel
+// Writes a pixel, clipped to the screen.
+static void SetPixel(uint16_t fb[Y_MAX][X_MAX], uint32_t x, uint32_t y, uint16_t color)
+{
+    if (x < X_MAX && y < Y_MAX)
+        fb[y][x] = color;
+}
+
+// Rect
+// Fills a rectangle like ST7789_DrawRectangle.
+static void Rect(uint16_t fb[Y_MAX][X_MAX], const displayOp_t *op)
+{
+    for (uint32_t y = op->y; y < (uint32_t) op->y + op->h; y++)
+    {
+        for (uint32_t x = op->x; x < (uint32_t) op->x + op->w; x++)
+            SetPixel(fb, x, y, op->color);
+    }
+}
+
+// Outline
+// Draws the border of a rectangle like ST7789_DrawOutline.
+static void Outline(uint16_t fb[Y_MAX][X_MAX], const displayOp_t *op)
+{
+    uint32_t x1 = op->x + op->w - 1, y1 = op->y + op->h - 1;
+
+    for (uint32_t x = op->x; x <= x1; x++)
+    {
+        SetPixel(fb, x, op->y, op->color);
+        SetPixel(fb, x, y1, op->color);
+    }
+    for (uint32_t y = op->y; y <= y1; y++)
+    {
+        SetPixel(fb, op->x, y, op->color);
+        SetPixel(fb, x1, y, op->color);
+    }
+}
+
+// Text
+// Draws a string like ST7789_DrawText, glyphs are stored bottom row first.
+static void Text(uint16_t fb[Y_MAX][X_MAX], const displayOp_t *op)
+{
+    const fontStyle_t *font = &FontStyle_Emulogic;
+    uint32_t x = op->x;
+
+    for (const char *c = op->data.text; *c; c++)
+    {
+        uint8_t index = *c - font->FirstAsciiCode;
+
+        if ((uint8_t) *c < font->FirstAsciiCode || index >= font->GlyphCount)
+            continue;
+
+        const uint8_t *glyph = &font->GlyphBitmaps[(index + 1) * font->GlyphBytesWidth
+                * font->GlyphHeight - font->GlyphBytesWidth];
+
+        for (uint32_t row = 0; row < font->GlyphHeight; row++)
+        {
+            const uint8_t *rowData = glyph - row * font->GlyphBytesWidth;
+
+            for (uint32_t col = 0; col < font->FixedWidth; col++)
+            {
+                SetPixel(fb, x + col, op->y + row,
+                         (rowData[col >> 3] & (0x80 >> (col & 7))) ? op->color : op->bgColor);
+            }
+        }
+        x += font->FixedWidth;
+    }
+}
+
+// Blit
+// Bitmap data isn't traced, so a pattern derived from the position is drawn.
+// Compositions and pattern tiles aren't either and get the same.
+static void Blit(uint16_t fb[Y_MAX][X_MAX], const displayOp_t *op)
+{
+    for (uint32_t y = op->y; y < (uint32_t) op->y + op->h; y++)
+    {
+        for (uint32_t x = op->x; x < (uint32_t) op->x + op->w; x++)
+            SetPixel(fb, x, y, ((x ^ y) & 8) ? 0x7BEF : 0x39E7);
+    }
+}
+
+// Execute
+// Draws a list into a framebuffer and returns the number of pixel bytes
+// the display would have been sent.
+static uint32_t Execute(uint16_t fb[Y_MAX][X_MAX], const displayOp_t *ops, uint16_t count)
+{
+    uint32_t bytes = 0;
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        const displayOp_t *op = &ops[i];
+
+        switch (op->type)
+        {
+        case DISPLAYLIST_RECT:
+            Rect(fb, op);
+            bytes += op->w * op->h * 2;
+            break;
+        case DISPLAYLIST_OUTLINE:
+            Outline(fb, op);
+            bytes += (op->w + op->h) * 4;
+            break;
+        case DISPLAYLIST_TEXT:
+            Text(fb, op);
+            bytes += op->w * op->h * 2;
+            break;
+        case DISPLAYLIST_BLIT:
+        case DISPLAYLIST_COMPOSITE:
+        case DISPLAYLIST_PATTERN:
+            Blit(fb, op);
+            bytes += op->w * op->h * 2;
+            break;
+        case DISPLAYLIST_SCROLL:
+            scrollTop = op->data.scroll.top;
+            scrollHeight = op->data.scroll.height;
+            scrollStart = op->data.scroll.start;
+            break;
+        case DISPLAYLIST_MODE:
+            mode = op->data.mode.mode;
+            if (mode & ST7789_MODE_PARTIAL)
+            {
+                partialTop = op->data.mode.top;
+                partialHeight = op->data.mode.height;
+            }
+            break;
+        }
+    }
+
+    return bytes;
+}
+
+// WritePPM
+// Writes a framebuffer as a binary PPM, as the panel shows it. Lines in
+// the scroll band come from the scrolled frame memory line, lines outside
+// the partial area are black in partial mode and all of them are asleep.
+// Idle mode keeps the top bit of each field. The panel is BGR and mounted
+// with row 0 at the bottom, so the image is flipped.
+static int WritePPM(const char *path, uint16_t fb[Y_MAX][X_MAX])
+{
+    FILE *f = fopen(path, "wb");
+
+    if (!f)
+        return 0;
+
+    fprintf(f, "P6\n%d %d\n255\n", X_MAX, Y_MAX);
+    for (int y = Y_MAX - 1; y >= 0; y--)
+    {
+        int line = y;
+        int shown = mode != ST7789_MODE_SLEEP;
+
+        if (y >= scrollTop && y < scrollTop + scrollHeight)
+            line = scrollTop + (y - scrollTop + scrollStart - scrollTop) % scrollHeight;
+
+        if (mode & ST7789_MODE_PARTIAL)
+            shown = shown && y >= partialTop && y < partialTop + partialHeight;
+
+        for (int x = 0; x < X_MAX; x++)
+        {
+            uint16_t c = shown ? fb[line][x] : 0;
+
+            if (mode == ST7789_MODE_IDLE || mode == ST7789_MODE_PARTIAL_IDLE)
+            {
+                c = (c & 0x8000 ? 0xF800 : 0) | (c & 0x0400 ? 0x07E0 : 0)
+                        | (c & 0x0010 ? 0x001F : 0);
+            }
+            uint8_t rgb[3] = { (c & 0x1F) << 3, ((c >> 5) & 0x3F) << 2, (c >> 11) << 3 };
+            fwrite(rgb, 1, 3, f);
+        }
+    }
+
+    fclose(f);
+    return 1;
+}
+
+/********************************Private Functions**********************************/
+
+/************************************MAIN*******************************************/
+
+int main(int argc, char **argv)
+{
+    FILE *f;
+    uint16_t n, m;
+    unsigned lists = 0, mismatches = 0, reordered = 0, opsIn = 0, opsOut = 0;
+    unsigned long bytesIn = 0, bytesOut = 0;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <trace.txt> [out.ppm]\n", argv[0]);
+        return 2;
+    }
+
+    f = fopen(argv[1], "r");
+    if (!f)
+    {
+        perror(argv[1]);
+        return 2;
+    }
+
+    while ((n = DLTrace_ReadList(f, recorded)) != DLTRACE_END)
+    {
+        memcpy(optimized, recorded, n * sizeof(displayOp_t));
+        m = DisplayList_Optimize(optimized, n);
+        memcpy(unordered, optimized, m * sizeof(displayOp_t));
+        DisplayList_Prioritize(optimized, m);
+        reordered += memcmp(unordered, optimized, m * sizeof(displayOp_t)) != 0;
+
+        bytesIn += Execute(fbRecorded, recorded, n);
+        bytesOut += Execute(fbOptimized, optimized, m);
+        opsIn += n;
+        opsOut += m;
+
+        if (memcmp(fbRecorded, fbOptimized, sizeof(fbRecorded)))
+        {
+            printf("list %u: optimized list draws a different frame\n", lists);
+            memcpy(fbOptimized, fbRecorded, sizeof(fbRecorded));
+            mismatches++;
+        }
+        lists++;
+    }
+    fclose(f);
+
+    printf("%u lists, %u ops -> %u ops, %lu pixel bytes -> %lu pixel bytes, %u reordered, "
+           "%u mismatches\n", lists, opsIn, opsOut, bytesIn, bytesOut, reordered, mismatches);
+
+    if (argc > 2 && !WritePPM(argv[2], fbRecorded))
+    {
+        perror(argv[2]);
+        return 2;
+    }
+
+    return mismatches ? 1 : 0;
+}
+
+/************************************MAIN*******************************************/
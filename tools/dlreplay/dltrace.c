@@ -0,0 +1,132 @@
+// dltrace.c
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-27
+// Reads display lists printed by DisplayList_SetTrace, shared by the host
+// tools.
+
+/************************************Includes***************************************/
+
+#include "dltrace.h"
+
+#include <ctype.h>
+#include <string.h>
+
+#include "multimod_ST7789.h"
+
+/************************************Includes***************************************/
+
+/********************************Public Functions***********************************/
+
+// DLTrace_ParseOp
+// Parses one op line of a trace. Text is drawn with FontStyle_Emulogic,
+// bitmap data and compositions aren't traced so blits and composites have
+// none, nor do patterns. The lane digit after the op letter is optional,
+// traces from before it was printed are all lane 0.
+// Param char* "line": line of the trace
+// Param displayOp_t* "op": parsed op
+// Return: int, 1 if an op was read
+int DLTrace_ParseOp(const char *line, displayOp_t *op)
+{
+    unsigned x, y, w, h, color = 0, bgColor = 0;
+    int text = 0;
+    const char *fields = line + 1;
+
+    memset(op, 0, sizeof(*op));
+
+    if (isdigit((unsigned char) *fields))
+    {
+        op->lane = *fields - '0';
+        fields++;
+    }
+
+    switch (line[0])
+    {
+    case 'R':
+    case 'O':
+        if (sscanf(fields, "%u %u %u %u %x", &x, &y, &w, &h, &color) != 5)
+            return 0;
+        op->type = line[0] == 'R' ? DISPLAYLIST_RECT : DISPLAYLIST_OUTLINE;
+        break;
+    case 'T':
+        if (sscanf(fields, "%u %u %u %u %x %x %n", &x, &y, &w, &h, &color, &bgColor, &text)
+                != 6)
+            return 0;
+        op->type = DISPLAYLIST_TEXT;
+        op->font = &FontStyle_Emulogic;
+        strncpy(op->data.text, fields + text, DISPLAYLIST_TEXT_LEN - 1);
+        op->data.text[strcspn(op->data.text, "\r\n")] = '\0';
+        break;
+    case 'B':
+    case 'C':
+    case 'P':
+        if (sscanf(fields, "%u %u %u %u", &x, &y, &w, &h) != 4)
+            return 0;
+        op->type = line[0] == 'B' ? DISPLAYLIST_BLIT :
+                   line[0] == 'C' ? DISPLAYLIST_COMPOSITE : DISPLAYLIST_PATTERN;
+        break;
+    case 'S':
+        if (sscanf(fields, "%u %u %u", &y, &h, &color) != 3)
+            return 0;
+        op->type = DISPLAYLIST_SCROLL;
+        op->data.scroll.top = y;
+        op->data.scroll.height = h;
+        op->data.scroll.start = color;
+        x = 0;
+        y = 0;
+        w = X_MAX;
+        h = Y_MAX;
+        color = 0;
+        break;
+    case 'M':
+        if (sscanf(fields, "%u %u %u", &color, &y, &h) != 3)
+            return 0;
+        op->type = DISPLAYLIST_MODE;
+        op->data.mode.mode = color;
+        op->data.mode.top = y;
+        op->data.mode.height = h;
+        x = 0;
+        y = 0;
+        w = X_MAX;
+        h = Y_MAX;
+        color = 0;
+        break;
+    default:
+        return 0;
+    }
+
+    op->x = x;
+    op->y = y;
+    op->w = w;
+    op->h = h;
+    op->color = color;
+    op->bgColor = bgColor;
+    return 1;
+}
+
+// DLTrace_ReadList
+// Reads the next list, skipping anything else that was on the UART.
+// Param FILE* "f": trace file
+// Param displayOp_t* "ops": room for DISPLAYLIST_MAX_OPS ops
+// Return: uint16_t, number of ops read, DLTRACE_END at the end of the trace
+uint16_t DLTrace_ReadList(FILE *f, displayOp_t *ops)
+{
+    char line[128];
+    unsigned count;
+    uint16_t n = 0;
+
+    while (fgets(line, sizeof(line), f))
+    {
+        // lists start with "L <count>"
+        if (sscanf(line, "L %u", &count) != 1 || count > DISPLAYLIST_MAX_OPS)
+            continue;
+
+        while (n < count && fgets(line, sizeof(line), f))
+            n += DLTrace_ParseOp(line, &ops[n]);
+
+        return n;
+    }
+
+    return DLTRACE_END;
+}
+
+/********************************Public Functions***********************************/
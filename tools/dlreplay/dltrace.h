@@ -0,0 +1,33 @@
+// dltrace.h
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-26
+// Reads display lists printed by DisplayList_SetTrace, shared by the host
+// tools.
+
+#ifndef DLTRACE_H_
+#define DLTRACE_H_
+
+/************************************Includes***************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "multimod_displaylist.h"
+
+/************************************Includes***************************************/
+
+/*************************************Defines***************************************/
+
+// DLTrace_ReadList return value at the end of the trace
+#define DLTRACE_END             0xFFFF
+
+/*************************************Defines***************************************/
+
+/********************************Public Functions***********************************/
+
+int DLTrace_ParseOp(const char *line, displayOp_t *op);
+uint16_t DLTrace_ReadList(FILE *f, displayOp_t *ops);
+
+/********************************Public Functions***********************************/
+
+#endif /* DLTRACE_H_ */
@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+#
+# sampletrace.py
+# Date Created: 2023-07-27
+# Date Updated: 2023-07-27
+# Writes the sample trace dlreplay and st7789emu are measured against,
+# tools/dlreplay/sample_trace.txt. Only needs the standard library.
+#
+# The trace is synthetic, not captured from the game: 300 lists of 1 to
+# 48 rects, outlines, text and blits at random places on a 4 pixel grid,
+# in the format DisplayList_SetTrace prints. Every list is preceded by a
+# line of other UART output, which the parser has to skip. The same seed
+# always gives the same trace.
+#
+# With --lanes every op gets a random lane after its letter, like
+# DisplayList_Render traces them, so DisplayList_Prioritize has something
+# to reorder. tools/dlreplay/lane_trace.txt is written this way.
+#
+# Usage (from the repository root):
+#   python3 tools/dlreplay/sampletrace.py
+#   python3 tools/dlreplay/sampletrace.py --lanes --out tools/dlreplay/lane_trace.txt
+#   python3 tools/dlreplay/sampletrace.py --seed 2 --lists 1000 --out big_trace.txt
+
+import argparse
+import random
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('--seed', type=int, default=1)
+    parser.add_argument('--lists', type=int, default=300)
+    parser.add_argument('--lanes', action='store_true')
+    parser.add_argument('--out', default='tools/dlreplay/sample_trace.txt')
+    args = parser.parse_args()
+
+    random.seed(args.seed)
+    out = []
+
+    for _ in range(args.lists):
+        n = random.randint(1, 48)
+        out.append('noise line\n')
+        out.append('L %u\n' % n)
+
+        for _ in range(n):
+            kind = random.choice('RRRRROTB')
+            x = random.randrange(0, 60) * 4
+            y = random.randrange(0, 80) * 4
+            w = random.choice([4, 8, 10, 20])
+            h = random.choice([4, 8, 10, 20])
+            color = random.choice([0, 0xFFFF, 0x1F])
+            op = kind + ('%u' % random.randrange(0, 3) if args.lanes else '')
+
+            if kind in 'RO':
+                out.append('%s %u %u %u %u %x\n' % (op, x, y, w, h, color))
+            elif kind == 'T':
+                out.append('%s %u %u 40 10 ffff 0 SCORE\n' % (op, x, y))
+            else:
+                out.append('%s %u %u %u %u\n' % (op, x, y, w, h))
+
+    with open(args.out, 'w') as f:
+        f.write(''.join(out))
+
+    print('%u lists' % args.lists)
+
+
+if __name__ == '__main__':
+    main()
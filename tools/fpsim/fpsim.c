@@ -0,0 +1,270 @@
+// fpsim.c
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-26
+// Host tool, runs the frame pacer stats against a simulated TE vsync and a
+// simulated game workload. Every workload is drawn twice, flushing as soon
+// as it is submitted and flushing at the next vsync, and both are scored
+// for tearing (the panel scanning a region while it is being written) and
+// frame timing. Exits non-zero if pacing doesn't hold the flush start to
+// just after vsync.
+//
+// Build from the repository root:
+//   cc -std=c99 -DFRAMEPACER_HOST -IMultimodDrivers -o fpsim tools/fpsim/fpsim.c
+//      MultimodDrivers/src/multimod_framepacer.c
+//
+// Usage:
+//   fpsim [seconds] [seed]
+
+/************************************Includes***************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "multimod_framepacer.h"
+
+/************************************Includes***************************************/
+
+/*************************************Defines***************************************/
+
+#define Y_MAX               320
+
+// ST7789 defaults, ~60 Hz with 8 line porches on both sides
+#define FRAME_NS            16666667ULL
+#define VSYNC_JITTER_NS     50000
+#define PORCH_LINES         8
+#define LINE_NS             (FRAME_NS / (Y_MAX + 2 * PORCH_LINES))
+
+// SPI_A_CLOCK_HZ, 20 MHz SCK, 8 bits per byte
+#define BYTE_NS             400
+#define WINDOW_BYTES        11
+
+// TE interrupt to render thread running
+#define WAKE_NS_MIN         5000
+#define WAKE_NS_MAX         25000
+
+// Game workload, a submit per input poll while a piece moves
+#define SUBMIT_NS           50000000ULL
+
+#define MAX_VSYNCS          (3600 * 60)
+
+// Flush start to vsync when paced, anything above is a failure
+#define PACED_LATENCY_MAX   (WAKE_NS_MAX + 1000)
+
+/*************************************Defines***************************************/
+
+/****************************Data Structure Definitions*****************************/
+
+/*
+ *  Simulated flush:
+ *      - Rows y to y + h are written top to bottom at the SPI rate
+ *      - Ready is when DisplayList_Submit would have woken the render thread
+ * */
+typedef struct flush_t
+{
+    uint64_t ready;
+    uint32_t y;
+    uint32_t h;
+    uint32_t bytes;
+} flush_t;
+
+/****************************Data Structure Definitions*****************************/
+
+/*******************************Private Variables***********************************/
+
+static uint64_t vsyncs[MAX_VSYNCS];
+static uint32_t vsyncCount;
+
+/*******************************Private Variables***********************************/
+
+/********************************Private Functions**********************************/
+
+// Random
+// Uniform random number in [lo, hi].
+static uint32_t Random(uint32_t lo, uint32_t hi)
+{
+    return lo + (uint32_t) (rand() % (hi - lo + 1));
+}
+
+// MakeVsyncs
+// Simulated TE source, rising edges with a little oscillator jitter.
+static void MakeVsyncs(uint64_t end)
+{
+    uint64_t t = Random(0, FRAME_NS);
+
+    for (vsyncCount = 0; t < end && vsyncCount < MAX_VSYNCS; vsyncCount++)
+    {
+        vsyncs[vsyncCount] = t;
+        t += FRAME_NS - VSYNC_JITTER_NS + Random(0, 2 * VSYNC_JITTER_NS);
+    }
+}
+
+// MakeFlush
+// A falling piece step: the old and new piece cells plus the shadow, as
+// a band of board rows, and sometimes a line clear redrawing the stack.
+static flush_t MakeFlush(uint64_t ready)
+{
+    flush_t f;
+    uint32_t cells;
+
+    f.ready = ready;
+
+    if (Random(0, 19) == 0)
+    {
+        f.h = Random(4, 20) * 10;
+        f.y = 83 + Random(0, 200 - f.h / 10 * 10);
+        cells = f.h / 10 * Random(5, 10);
+    }
+    else
+    {
+        f.h = Random(2, 6) * 10;
+        f.y = 83 + Random(0, 20 - f.h / 10) * 10;
+        cells = Random(8, 12);
+    }
+
+    f.bytes = cells * (WINDOW_BYTES + 10 * 10 * 2);
+
+    return f;
+}
+
+// FirstVsync
+// Index of the first vsync at or after t, vsyncCount if there is none.
+static uint32_t FirstVsync(uint64_t t)
+{
+    uint32_t lo = 0, hi = vsyncCount;
+
+    while (lo < hi)
+    {
+        uint32_t mid = (lo + hi) / 2;
+
+        if (vsyncs[mid] < t)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+// ScanLine
+// Line the panel is reading at time t, or -1 in the porches.
+static int32_t ScanLine(uint64_t t)
+{
+    uint32_t i = FirstVsync(t + 1);
+    int64_t line;
+
+    if (!i)
+        return -1;
+
+    line = (int64_t) ((t - vsyncs[i - 1]) / LINE_NS) - PORCH_LINES;
+
+    return line >= 0 && line < Y_MAX ? (int32_t) line : -1;
+}
+
+// Tears
+// Checks if the scan line enters the rows of a flush while they are being
+// written, so one refresh shows part of the old and part of the new frame.
+static int Tears(const flush_t *f, uint64_t start, uint64_t end)
+{
+    for (uint64_t t = start; t < end; t += LINE_NS / 4)
+    {
+        int32_t line = ScanLine(t);
+
+        if (line >= (int32_t) f->y && line < (int32_t) (f->y + f->h))
+            return 1;
+    }
+
+    return 0;
+}
+
+// Run
+// Draws the workload with or without pacing and prints the result.
+// Return: uint32_t, number of torn flushes
+static uint32_t Run(const char *name, const flush_t *flushes, uint32_t count, int paced,
+                    framePacerStats_t *stats)
+{
+    uint64_t busy = 0;
+    uint32_t v = 0, torn = 0;
+
+    FramePacer_ResetStats(stats);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const flush_t *f = &flushes[i];
+        uint64_t start = f->ready > busy ? f->ready : busy;
+        uint64_t end;
+
+        if (paced)
+        {
+            uint32_t vsync = FirstVsync(start);
+
+            if (vsync == vsyncCount)
+                break;
+            start = vsyncs[vsync] + Random(WAKE_NS_MIN, WAKE_NS_MAX);
+        }
+
+        end = start + (uint64_t) f->bytes * BYTE_NS;
+
+        while (v < vsyncCount && vsyncs[v] <= start)
+            FramePacer_RecordVsync(stats, vsyncs[v++]);
+
+        FramePacer_RecordFlush(stats, start, end);
+        torn += Tears(f, start, end);
+        busy = end;
+    }
+
+    printf("%-8s %5u frames, %4u torn, %u late, vsync to flush %6u us avg, jitter %6u us,"
+           " interval %u-%u us\n",
+           name, stats->flushes, torn, stats->late,
+           (uint32_t) (stats->latencySum / (stats->flushes ? stats->flushes : 1) / 1000),
+           FramePacer_Jitter(stats) / 1000, stats->intervalMin / 1000,
+           stats->intervalMax / 1000);
+
+    return torn;
+}
+
+/********************************Private Functions**********************************/
+
+int main(int argc, char **argv)
+{
+    uint32_t seconds = argc > 1 ? (uint32_t) atoi(argv[1]) : 60;
+    uint64_t end;
+    flush_t *flushes;
+    uint32_t count = 0, tornRaw, tornPaced;
+    framePacerStats_t raw, paced;
+
+    srand(argc > 2 ? (unsigned) atoi(argv[2]) : 1);
+
+    if (seconds < 1 || seconds > MAX_VSYNCS / 60)
+    {
+        fprintf(stderr, "usage: fpsim [seconds 1-%u] [seed]\n", MAX_VSYNCS / 60);
+        return 1;
+    }
+
+    end = (uint64_t) seconds * 1000000000ULL;
+    MakeVsyncs(end);
+
+    flushes = malloc(sizeof(flush_t) * (end / SUBMIT_NS + 1));
+    if (!flushes)
+        return 1;
+
+    // submits follow the 50 ms input poll, after however long the game
+    // threads took, and stop a frame early so the last ones still get a vsync
+    for (uint64_t t = Random(0, SUBMIT_NS); t + FRAME_NS * 2 < end; t += SUBMIT_NS)
+        flushes[count++] = MakeFlush(t + Random(0, FRAME_NS));
+
+    printf("%u s, %u vsyncs, %u submits\n", seconds, vsyncCount, count);
+
+    tornRaw = Run("submit", flushes, count, 0, &raw);
+    tornPaced = Run("vsync", flushes, count, 1, &paced);
+
+    free(flushes);
+
+    if (paced.flushes != count || paced.latencyMax > PACED_LATENCY_MAX || tornPaced > tornRaw)
+    {
+        printf("FAIL\n");
+        return 1;
+    }
+
+    printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+#
+# glyphcache.py
+# Date Created: 2023-07-26
+# Date Updated: 2023-07-26
+# Pre-expands the glyphs the HUD draws into runs, as
+# MultimodDrivers/glyphcache.h and MultimodDrivers/src/glyphcache.c.
+# ST7789_DrawText walks these instead of testing every bit of the font.
+# Only needs the standard library.
+#
+# Glyphs are read from the Emulogic bitmaps in MultimodDrivers/src/fontlibrary.c.
+# Every cached row is stored as run lengths, alternating background and
+# glyph color and starting with background (which may be a 0 length run),
+# adding up to the font width. Rows are stored bottom row first like the
+# sprites, since the panel's row addresses count up from the bottom of the
+# screen. The runs don't depend on the colors, so one copy serves any
+# color pair and both color modes. Index maps every glyph of the font to
+# its cache slot, or GLYPHCACHE_NONE.
+#
+# Usage (from the repository root):
+#   python3 tools/glyphcache/glyphcache.py
+#   python3 tools/glyphcache/glyphcache.py --chars " 0123456789HIGSCORELV"
+
+import argparse
+import os
+import re
+import sys
+
+# digits and the letters of the HIGH, SCORE and LEVEL labels
+DEFAULT_CHARS = ' 0123456789CEGHILORSV'
+
+
+def read_font(path, name):
+    """Reads the bitmaps and layout of a font from fontlibrary.c."""
+    with open(path) as f:
+        source = f.read()
+
+    bitmaps = re.search(r'%s_Bitmaps\[\d+\]\s*=\s*\{(.*?)\};' % name, source, re.S)
+    style = re.search(r'FontStyle_%s\s*=\s*\{(.*?)\};' % name, source, re.S)
+    if not bitmaps or not style:
+        raise ValueError('%s: no %s font' % (path, name))
+
+    data = [int(v, 16) for v in re.findall(r'0x[0-9a-fA-F]+', re.sub(r'//.*', '', bitmaps.group(1)))]
+    fields = [int(v) for v in re.findall(r'^\s*(\d+),', re.sub(r'//.*', '', style.group(1)), re.M)]
+    count, first, bytes_width, height, width = fields[:5]
+
+    if len(data) != count * bytes_width * height:
+        raise ValueError('%s: %s has %u bytes, expected %u'
+                         % (path, name, len(data), count * bytes_width * height))
+
+    return count, first, bytes_width, height, width, data
+
+
+def glyph_runs(data, index, bytes_width, height, width):
+    """Run lengths of one glyph, bottom row first."""
+    runs = []
+    base = index * bytes_width * height
+
+    for row in reversed(range(height)):
+        bits = data[base + row * bytes_width:base + (row + 1) * bytes_width]
+        fg = False
+        run = 0
+
+        for col in range(width):
+            on = bool(bits[col >> 3] & (0x80 >> (col & 7)))
+            if on != fg:
+                runs.append(run)
+                fg = on
+                run = 0
+            run += 1
+        runs.append(run)
+
+    return runs
+
+
+def c_array(ctype, name, values, per_line, fmt):
+    lines = ['static %s const %s[%u] = {' % (ctype, name, len(values))]
+    for i in range(0, len(values), per_line):
+        lines.append('        ' + ', '.join(fmt % v for v in values[i:i + per_line]) + ',')
+    lines.append('};')
+    return '\n'.join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('--chars', default=DEFAULT_CHARS, help='characters to cache')
+    parser.add_argument('--font', default='MultimodDrivers/src/fontlibrary.c')
+    parser.add_argument('--out', default='MultimodDrivers', help='driver directory to write to')
+    args = parser.parse_args()
+
+    name = 'Emulogic'
+    count, first, bytes_width, height, width, data = read_font(args.font, name)
+
+    chars = sorted(set(args.chars))
+    for c in chars:
+        if not first <= ord(c) < first + count:
+            sys.exit('%r is not in the %s font' % (c, name))
+
+    index = [0xFF] * count
+    offsets = []
+    runs = []
+    for slot, c in enumerate(chars):
+        index[ord(c) - first] = slot
+        offsets.append(len(runs))
+        runs += glyph_runs(data, ord(c) - first, bytes_width, height, width)
+
+    header = '''//
+// Glyph cache C header file generated by glyphcache.py
+//
+
+#ifndef GLYPHCACHE_H_
+#define GLYPHCACHE_H_
+
+#include <stdint.h>
+#include "fontlibrary.h"
+
+// Index of a glyph that isn't cached
+#define GLYPHCACHE_NONE 0xFF
+
+typedef struct
+{
+    fontStyle_t const *Font;
+    uint8_t const *Index;
+    uint16_t const *Offsets;
+    uint8_t const *Runs;
+} glyphCache_t;
+
+extern const glyphCache_t GlyphCache_%s;
+
+#endif /* GLYPHCACHE_H_ */
+''' % name
+
+    source = '''//
+// Glyph cache C source generated by glyphcache.py
+//
+
+#include <stdint.h>
+#include "../glyphcache.h"
+
+// %u glyphs of %s, "%s", %u bytes of runs (%u bytes as bitmaps)
+%s
+
+%s
+
+%s
+
+const glyphCache_t GlyphCache_%s = { &FontStyle_%s, // Font
+        %s_Index, %s_Offsets, %s_Runs };
+''' % (len(chars), name, ''.join(chars), len(runs), len(chars) * bytes_width * height,
+       c_array('uint8_t', '%s_Index' % name, index, 12, '0x%02X'),
+       c_array('uint16_t', '%s_Offsets' % name, offsets, 12, '%u'),
+       c_array('uint8_t', '%s_Runs' % name, runs, 16, '%u'),
+       name, name, name, name, name)
+
+    with open(os.path.join(args.out, 'glyphcache.h'), 'w') as f:
+        f.write(header)
+    with open(os.path.join(args.out, 'src', 'glyphcache.c'), 'w') as f:
+        f.write(source)
+
+    print('%u glyphs, %u bytes of runs' % (len(chars), len(runs)))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,332 @@
+// rastercheck.c
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-26
+// Host tool, checks that lines and outlines from multimod_raster cover
+// exactly the pixels the old point by point ST7789_Line and four line
+// ST7789_DrawOutline did, clipped like the driver clips them. Also counts
+// the windows each way needs.
+//
+// Build from the repository root:
+//   cc -std=c99 -IMultimodDrivers -o rastercheck tools/rastercheck/rastercheck.c
+//      MultimodDrivers/src/multimod_raster.c
+//
+// Usage:
+//   rastercheck [random lines]
+
+/************************************Includes***************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "multimod_raster.h"
+
+/************************************Includes***************************************/
+
+/*************************************Defines***************************************/
+
+#define X_MAX               240
+#define Y_MAX               320
+
+// every line with both ends in a GRID x GRID square is checked, placed
+// against the bottom right corner so clipping is covered too
+#define GRID                24
+
+#ifndef _swap_int16_t
+#define _swap_int16_t(a, b) \
+{  \
+    int16_t t = a; \
+    a = b; \
+    b = t; \
+}
+#endif
+
+/*************************************Defines***************************************/
+
+/*******************************Private Variables***********************************/
+
+static uint32_t fbOld[Y_MAX][X_MAX];
+static uint32_t fbNew[Y_MAX][X_MAX];
+static uint32_t generation;
+
+static uint32_t windowsOld, windowsNew, pixelsOld, pixelsNew, bytesOld, bytesNew;
+
+// pixels touched this generation
+static uint16_t minX, minY, maxX, maxY;
+
+// last window, like ST7789_SetWindow
+static uint16_t windowX0, windowX1, windowY0, windowY1;
+
+/*******************************Private Variables***********************************/
+
+/********************************Private Functions**********************************/
+
+// Touch
+// Grows the area Compare looks at.
+static void Touch(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    if (x < minX)
+        minX = x;
+    if (y < minY)
+        minY = y;
+    if (x + w - 1 > maxX)
+        maxX = x + w - 1;
+    if (y + h - 1 > maxY)
+        maxY = y + h - 1;
+}
+
+// OldWindow
+// A window of the old drawing code, clipped like ST7789_DrawPixel,
+// ST7789_DrawHLine and ST7789_DrawVLine.
+static void OldWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    if (x >= X_MAX || y >= Y_MAX || !w || !h)
+        return;
+
+    if (x + w > X_MAX)
+        w = X_MAX - x;
+    if (y + h > Y_MAX)
+        h = Y_MAX - y;
+
+    windowsOld++;
+    bytesOld += 11;
+    Touch(x, y, w, h);
+    for (uint16_t j = y; j < y + h; j++)
+    {
+        for (uint16_t i = x; i < x + w; i++)
+        {
+            fbOld[j][i] = generation;
+            pixelsOld++;
+        }
+    }
+}
+
+// NewSpan
+// A run from multimod_raster, clipped like ST7789_Span.
+static void NewSpan(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+    (void) color;
+
+    if (x >= X_MAX || y >= Y_MAX || !w || !h)
+        return;
+
+    if (x + w > X_MAX)
+        w = X_MAX - x;
+    if (y + h > Y_MAX)
+        h = Y_MAX - y;
+
+    windowsNew++;
+    bytesNew++;
+    if (x != windowX0 || x + w - 1 != windowX1)
+        bytesNew += 5;
+    if (y != windowY0 || y + h - 1 != windowY1)
+        bytesNew += 5;
+    windowX0 = x;
+    windowX1 = x + w - 1;
+    windowY0 = y;
+    windowY1 = y + h - 1;
+    Touch(x, y, w, h);
+    for (uint16_t j = y; j < y + h; j++)
+    {
+        for (uint16_t i = x; i < x + w; i++)
+        {
+            fbNew[j][i] = generation;
+            pixelsNew++;
+        }
+    }
+}
+
+// OldLine
+// ST7789_Line before runs, one pixel window per point.
+static void OldLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
+{
+    bool steep = abs((int16_t) (y1 - y0)) > abs((int16_t) (x1 - x0));
+    if (steep)
+    {
+        _swap_int16_t(x0, y0);
+        _swap_int16_t(x1, y1);
+    }
+
+    if (x0 > x1)
+    {
+        _swap_int16_t(x0, x1);
+        _swap_int16_t(y0, y1);
+    }
+
+    int16_t dx, dy;
+    dx = x1 - x0;
+    dy = abs((int16_t) (y1 - y0));
+
+    int16_t err = dx / 2;
+    int16_t ystep = y0 < y1 ? 1 : -1;
+
+    for (; x0 <= x1; x0++)
+    {
+        if (steep)
+            OldWindow(y0, x0, 1, 1);
+        else
+            OldWindow(x0, y0, 1, 1);
+
+        err -= dy;
+        if (err < 0)
+        {
+            y0 += ystep;
+            err += dx;
+        }
+    }
+}
+
+// OldDrawLine
+// ST7789_DrawLine, axis aligned lines are one window.
+static void OldDrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
+{
+    if (x0 == x1)
+    {
+        if (y0 > y1)
+            _swap_int16_t(y0, y1);
+        OldWindow(x0, y0, 1, y1 - y0 + 1);
+    }
+    else if (y0 == y1)
+    {
+        if (x0 > x1)
+            _swap_int16_t(x0, x1);
+        OldWindow(x0, y0, x1 - x0 + 1, 1);
+    }
+    else
+    {
+        OldLine(x0, y0, x1, y1);
+    }
+}
+
+// Compare
+// Checks both framebuffers hold the same pixels of the current generation,
+// then starts a new touched area.
+// Return: int, 1 if they match
+static int Compare(void)
+{
+    for (uint16_t y = minY; y <= maxY && y < Y_MAX; y++)
+    {
+        for (uint16_t x = minX; x <= maxX && x < X_MAX; x++)
+        {
+            if ((fbOld[y][x] == generation) != (fbNew[y][x] == generation))
+                return 0;
+        }
+    }
+
+    minX = X_MAX;
+    minY = Y_MAX;
+    maxX = maxY = 0;
+
+    return 1;
+}
+
+// CheckLine
+// Draws a line both ways.
+// Return: int, 1 if they match
+static int CheckLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
+{
+    generation++;
+    OldLine(x0, y0, x1, y1);
+    Raster_Line(x0, y0, x1, y1, 0, NewSpan);
+
+    if (!Compare())
+    {
+        printf("line %u,%u - %u,%u differs\n", x0, y0, x1, y1);
+        return 0;
+    }
+
+    return 1;
+}
+
+// CheckOutline
+// Draws an outline both ways.
+// Return: int, 1 if they match
+static int CheckOutline(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    generation++;
+    OldDrawLine(x, y, x + w - 1, y);
+    OldDrawLine(x, y, x, y + h - 1);
+    OldDrawLine(x, y + h - 1, x + w - 1, y + h - 1);
+    OldDrawLine(x + w - 1, y, x + w - 1, y + h - 1);
+    Raster_Outline(x, y, w, h, 0, NewSpan);
+
+    if (!Compare())
+    {
+        printf("outline %u,%u %ux%u differs\n", x, y, w, h);
+        return 0;
+    }
+
+    return 1;
+}
+
+// Report
+// Prints and clears the window counts. Command bytes are CASET, RASET and
+// RAMWR with their parameters, after leaving out unchanged ranges.
+static void Report(const char *name, uint32_t count)
+{
+    printf("%s (%u)\n  before: %u windows, %u command bytes, %u pixels\n"
+           "  after:  %u windows, %u command bytes, %u pixels\n", name, count, windowsOld,
+           bytesOld, pixelsOld, windowsNew, bytesNew, pixelsNew);
+    windowsOld = windowsNew = pixelsOld = pixelsNew = bytesOld = bytesNew = 0;
+}
+
+/********************************Private Functions**********************************/
+
+int main(int argc, char **argv)
+{
+    uint32_t lines = argc > 1 ? (uint32_t) atoi(argv[1]) : 20000;
+    uint32_t count = 0, failed = 0;
+    uint16_t ox = X_MAX - GRID / 2, oy = Y_MAX - GRID / 2;
+
+    srand(1);
+    minX = X_MAX;
+    minY = Y_MAX;
+
+    // exhaustive lines, half of the square is off the screen
+    for (uint16_t a = 0; a < GRID * GRID; a++)
+    {
+        for (uint16_t b = 0; b < GRID * GRID; b++)
+        {
+            count++;
+            failed += !CheckLine(ox + a % GRID, oy + a / GRID, ox + b % GRID, oy + b / GRID);
+            if (failed > 10)
+                return 1;
+        }
+    }
+    Report("lines (grid)", count);
+
+    for (count = 0; count < lines; count++)
+    {
+        failed += !CheckLine(rand() % X_MAX, rand() % Y_MAX, rand() % X_MAX, rand() % Y_MAX);
+        if (failed > 10)
+            return 1;
+    }
+    Report("lines (random)", count);
+
+    // every outline up to 16x16 in a square crossing the screen corner
+    count = 0;
+    for (uint16_t y = oy; y < oy + GRID; y++)
+    {
+        for (uint16_t x = ox; x < ox + GRID; x++)
+        {
+            for (uint16_t h = 1; h <= 16; h++)
+            {
+                for (uint16_t w = 1; w <= 16; w++)
+                {
+                    count++;
+                    failed += !CheckOutline(x, y, w, h);
+                    if (failed > 10)
+                        return 1;
+                }
+            }
+        }
+    }
+    Report("outlines", count);
+
+    // the ghost piece cells
+    for (count = 0; count < 4; count++)
+        failed += !CheckOutline(61, 84 + 10 * count, 8, 8);
+    Report("8x8 ghost cells", count);
+
+    printf(failed ? "FAIL\n" : "OK\n");
+    return failed ? 1 : 0;
+}
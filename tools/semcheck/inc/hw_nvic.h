@@ -0,0 +1,10 @@
+// hw_nvic.h
+// Date Created: 2023-07-27
+// Date Updated: 2023-07-27
+// Host stand-in for the TivaWare header. G8RTOS_Semaphores.c includes it
+// but uses none of it.
+
+#ifndef __HW_NVIC_H__
+#define __HW_NVIC_H__
+
+#endif // __HW_NVIC_H__
@@ -0,0 +1,12 @@
+// hw_types.h
+// Date Created: 2023-07-27
+// Date Updated: 2023-07-27
+// Host stand-in for the TivaWare header. G8RTOS_Semaphores.c includes it
+// but uses none of it.
+
+#ifndef __HW_TYPES_H__
+#define __HW_TYPES_H__
+
+#include <stdint.h>
+
+#endif // __HW_TYPES_H__
@@ -0,0 +1,187 @@
+// semcheck.c
+// Date Created: 2023-07-27
+// Date Updated: 2023-07-27
+// Host tool, runs the real G8RTOS_Semaphores.c against a stand-in scheduler
+// to check no signal gets lost. An interrupt is raised at each point where
+// the hardware could take one: between a thread blocking itself and its
+// G8RTOS_Yield, where the SysTick timer callbacks, the TE edge and the SSI0
+// uDMA done interrupt all signal from. A thread that is still blocked
+// after its yield would never run again. Exits non-zero on any lost
+// signal.
+//
+// Build from the repository root (-fcommon like the target build, the
+// G8RTOS headers define SystemTime and IBit_State):
+//   cc -std=c99 -fcommon -Itools/semcheck -o semcheck tools/semcheck/semcheck.c
+//      G8RTOS/src/G8RTOS_Semaphores.c
+//
+// Usage:
+//   semcheck
+
+/************************************Includes***************************************/
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../../G8RTOS/G8RTOS_CriticalSection.h"
+#include "../../G8RTOS/G8RTOS_Scheduler.h"
+#include "../../G8RTOS/G8RTOS_Semaphores.h"
+
+/************************************Includes***************************************/
+
+/*************************************Defines***************************************/
+
+#define THREADS             3
+
+/*************************************Defines***************************************/
+
+/********************************Public Variables***********************************/
+
+tcb_t *CurrentlyRunningThread;
+
+/********************************Public Variables***********************************/
+
+/*******************************Private Variables***********************************/
+
+static tcb_t threads[THREADS];
+
+// kernel critical section nesting, interrupts are only taken outside one
+static uint32_t criticalDepth;
+
+// interrupt taken at the next G8RTOS_Yield, before the switch
+static void (*pendingIsr)(void);
+
+static semaphore_t sem_a;
+static semaphore_t sem_b;
+static semaphore_t sem_c;
+
+static uint32_t failures;
+
+/*******************************Private Variables***********************************/
+
+/********************************Private Functions**********************************/
+
+// Check
+// Counts and prints a failed check.
+static void Check(bool ok, const char *name)
+{
+    printf("%-44s %s\n", name, ok ? "ok" : "LOST");
+    if (!ok)
+        failures++;
+}
+
+// Reset
+// Puts every thread in the ring unblocked, with the first one running, and
+// every semaphore at 0.
+static void Reset(void)
+{
+    for (uint8_t i = 0; i < THREADS; i++)
+    {
+        threads[i].nextTCB = &threads[(i + 1) % THREADS];
+        threads[i].previousTCB = &threads[(i + THREADS - 1) % THREADS];
+        threads[i].blocked = 0;
+        threads[i].waitSet = 0;
+        threads[i].waitCount = 0;
+        threads[i].waitResult = -1;
+    }
+
+    CurrentlyRunningThread = &threads[0];
+    criticalDepth = 0;
+    pendingIsr = 0;
+    sem_a = sem_b = sem_c = 0;
+}
+
+static void SignalA(void)
+{
+    G8RTOS_SignalSemaphore(&sem_a);
+}
+
+static void SignalB(void)
+{
+    G8RTOS_SignalSemaphore(&sem_b);
+}
+
+/********************************Private Functions**********************************/
+
+/****************************Stand-in Kernel Functions******************************/
+
+int32_t StartKernelCriticalSection()
+{
+    criticalDepth++;
+    return 0;
+}
+
+void EndKernelCriticalSection(int32_t BasePri_State)
+{
+    criticalDepth--;
+}
+
+// G8RTOS_Yield
+// The running thread is still the one yielding until PendSV switches, so an
+// interrupt taken here sees it as CurrentlyRunningThread.
+void G8RTOS_Yield()
+{
+    if (pendingIsr && !criticalDepth)
+    {
+        void (*isr)(void) = pendingIsr;
+
+        pendingIsr = 0;
+        isr();
+    }
+}
+
+/****************************Stand-in Kernel Functions******************************/
+
+/************************************MAIN*******************************************/
+
+int main(void)
+{
+    semaphore_t *set[] = { &sem_a, &sem_b };
+    int32_t result;
+
+    // the render thread in FramePacer_WaitVsync, the timeout fires just
+    // before its yield
+    Reset();
+    pendingIsr = SignalB;
+    result = G8RTOS_WaitAny(set, 2);
+    Check(!threads[0].blocked && result == 1, "WaitAny, signalled before its yield");
+
+    // same with the first in the set
+    Reset();
+    pendingIsr = SignalA;
+    result = G8RTOS_WaitAny(set, 2);
+    Check(!threads[0].blocked && result == 0, "WaitAny, first signalled before its yield");
+
+    // a signal for a semaphore outside the set leaves it blocked
+    Reset();
+    pendingIsr = 0;
+    G8RTOS_WaitAny(set, 2);
+    G8RTOS_SignalSemaphore(&sem_c);
+    Check(threads[0].blocked != 0, "WaitAny, other semaphore signalled");
+
+    // waiting in another thread, signalled from the running one
+    Reset();
+    G8RTOS_WaitAny(set, 2);
+    CurrentlyRunningThread = &threads[1];
+    G8RTOS_SignalSemaphore(&sem_b);
+    Check(!threads[0].blocked && threads[0].waitResult == 1, "WaitAny, signalled by a thread");
+
+    // plain wait, signalled before its yield
+    Reset();
+    pendingIsr = SignalA;
+    G8RTOS_WaitSemaphore(&sem_a);
+    Check(!threads[0].blocked && sem_a == 0, "WaitSemaphore, signalled before its yield");
+
+    // plain wait in another thread, signalled from the running one
+    Reset();
+    G8RTOS_WaitSemaphore(&sem_a);
+    CurrentlyRunningThread = &threads[2];
+    G8RTOS_SignalSemaphore(&sem_a);
+    Check(!threads[0].blocked && sem_a == 0, "WaitSemaphore, signalled by a thread");
+
+    printf("%u lost signals\n", failures);
+
+    return failures ? 1 : 0;
+}
+
+/************************************MAIN*******************************************/
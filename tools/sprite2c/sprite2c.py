@@ -0,0 +1,249 @@
+#!/usr/bin/env python3
+#
+# sprite2c.py
+# Date Created: 2023-07-26
+# Date Updated: 2023-07-26
+# Converts PNGs into the compressed sprites drawn by ST7789_DrawSprite, as
+# MultimodDrivers/spritelibrary.h and MultimodDrivers/src/spritelibrary.c.
+# Only needs the standard library.
+#
+# Every sprite is stored in whichever format is smallest:
+#   SPRITE_RLE565       runs of (count - 1, color high byte, color low byte),
+#                       1 to 256 pixels per run
+#   SPRITE_INDEXED      16 color palette, two pixels per byte, high nibble first
+#   SPRITE_INDEXED_RLE  16 color palette, one byte per run of (count - 1) << 4
+#                       | index, 1 to 16 pixels per run
+# Pixels run left to right, bottom row first, since the panel's row addresses
+# count up from the bottom of the screen (ST7789_DrawText walks the font
+# glyphs backwards for the same reason). Colors are written BGR565 like the
+# ST7789_ color defines. Transparent pixels (alpha below 128) are replaced
+# with the background color.
+#
+# Usage (from the repository root):
+#   python3 tools/sprite2c/sprite2c.py tools/sprite2c/assets/*.png
+#   python3 tools/sprite2c/sprite2c.py --format rle565 --background 0x0000 logo.png
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+FORMATS = ('rle565', 'indexed', 'indexed_rle')
+
+
+def read_png(path):
+    """Decodes an 8-bit PNG into rows of (r, g, b, a) tuples."""
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        raise ValueError('%s: not a PNG' % path)
+
+    pos = 8
+    idat = b''
+    palette = []
+    alpha = []
+    while pos < len(data):
+        length, kind = struct.unpack('>I4s', data[pos:pos + 8])
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+
+        if kind == b'IHDR':
+            width, height, depth, ctype, _, _, interlace = struct.unpack('>IIBBBBB', chunk)
+        elif kind == b'PLTE':
+            palette = [tuple(chunk[i:i + 3]) for i in range(0, len(chunk), 3)]
+        elif kind == b'tRNS':
+            alpha = list(chunk)
+        elif kind == b'IDAT':
+            idat += chunk
+        elif kind == b'IEND':
+            break
+
+    if depth != 8 or interlace:
+        raise ValueError('%s: only 8-bit, non-interlaced PNGs are supported' % path)
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[ctype]
+    stride = width * channels
+    raw = zlib.decompress(idat)
+    rows = []
+    prev = bytearray(stride)
+
+    for y in range(height):
+        base = y * (stride + 1)
+        filt = raw[base]
+        line = bytearray(raw[base + 1:base + 1 + stride])
+
+        for i in range(stride):
+            a = line[i - channels] if i >= channels else 0
+            b = prev[i]
+            c = prev[i - channels] if i >= channels else 0
+            if filt == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif filt == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif filt == 3:
+                line[i] = (line[i] + (a + b) // 2) & 0xFF
+            elif filt == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                pred = a if pa <= pb and pa <= pc else (b if pb <= pc else c)
+                line[i] = (line[i] + pred) & 0xFF
+
+        pixels = []
+        for x in range(width):
+            px = line[x * channels:(x + 1) * channels]
+            if ctype == 0:
+                pixels.append((px[0], px[0], px[0], 255))
+            elif ctype == 2:
+                pixels.append((px[0], px[1], px[2], 255))
+            elif ctype == 3:
+                r, g, b = palette[px[0]]
+                pixels.append((r, g, b, alpha[px[0]] if px[0] < len(alpha) else 255))
+            elif ctype == 4:
+                pixels.append((px[0], px[0], px[0], px[1]))
+            else:
+                pixels.append(tuple(px))
+
+        rows.append(pixels)
+        prev = line
+
+    return width, height, rows
+
+
+def to_bgr565(pixel, background):
+    r, g, b, a = pixel
+    if a < 128:
+        return background
+    return (b >> 3) << 11 | (g >> 2) << 5 | (r >> 3)
+
+
+def encode_rle565(pixels):
+    out = bytearray()
+    i = 0
+    while i < len(pixels):
+        n = 1
+        while i + n < len(pixels) and n < 256 and pixels[i + n] == pixels[i]:
+            n += 1
+        out += bytes((n - 1, pixels[i] >> 8, pixels[i] & 0xFF))
+        i += n
+    return out
+
+
+def encode_indexed(indices):
+    out = bytearray()
+    for i in range(0, len(indices), 2):
+        lo = indices[i + 1] if i + 1 < len(indices) else 0
+        out.append(indices[i] << 4 | lo)
+    return out
+
+
+def encode_indexed_rle(indices):
+    out = bytearray()
+    i = 0
+    while i < len(indices):
+        n = 1
+        while i + n < len(indices) and n < 16 and indices[i + n] == indices[i]:
+            n += 1
+        out.append((n - 1) << 4 | indices[i])
+        i += n
+    return out
+
+
+def encode(pixels, fmt):
+    """Returns (format, palette, data) for the requested or smallest format."""
+    palette = list(dict.fromkeys(pixels))
+    options = [('rle565', [], encode_rle565(pixels))]
+
+    if len(palette) <= 16:
+        lookup = {color: i for i, color in enumerate(palette)}
+        indices = [lookup[p] for p in pixels]
+        options.append(('indexed', palette, encode_indexed(indices)))
+        options.append(('indexed_rle', palette, encode_indexed_rle(indices)))
+
+    if fmt:
+        options = [o for o in options if o[0] == fmt]
+        if not options:
+            raise ValueError('more than 16 colors, use rle565')
+
+    return min(options, key=lambda o: len(o[2]) + 2 * len(o[1]))
+
+
+def sprite_name(path):
+    stem = os.path.splitext(os.path.basename(path))[0]
+    return ''.join(part[:1].upper() + part[1:] for part in stem.replace('-', '_').split('_'))
+
+
+def write_header(path, names):
+    with open(path, 'w', newline='\n') as f:
+        f.write('//\n// Sprite C header file generated by sprite2c.py\n//\n\n')
+        f.write('#ifndef SPRITELIBRARY_H_\n#define SPRITELIBRARY_H_\n\n')
+        f.write('#include <stdint.h>\n\n')
+        f.write('typedef enum\n{\n    SPRITE_RLE565 = 0,\n    SPRITE_INDEXED = 1,\n'
+                '    SPRITE_INDEXED_RLE = 2\n} spriteFormat_t;\n\n')
+        f.write('typedef struct\n{\n    uint16_t Width;\n    uint16_t Height;\n'
+                '    uint8_t Format;\n    uint8_t PaletteSize;\n    uint16_t const *Palette;\n'
+                '    uint8_t const *Data;\n    uint32_t DataSize;\n} sprite_t;\n\n')
+        for name in names:
+            f.write('extern const sprite_t Sprite_%s;\n' % name)
+        f.write('\n#endif /* SPRITELIBRARY_H_ */\n')
+
+
+def write_source(path, sprites):
+    with open(path, 'w', newline='\n') as f:
+        f.write('//\n// Sprite C source generated by sprite2c.py\n//\n\n')
+        f.write('#include <stdint.h>\n#include "../spritelibrary.h"\n')
+
+        for name, src, width, height, fmt, palette, data in sprites:
+            f.write('\n// %s, %ux%u, %s, %u bytes (%u raw)\n'
+                    % (src, width, height, fmt, len(data) + 2 * len(palette), width * height * 2))
+
+            if palette:
+                f.write('static uint16_t const %s_Palette[%u] = {\n' % (name, len(palette)))
+                for i in range(0, len(palette), 8):
+                    f.write('        ' + ', '.join('0x%04X' % c for c in palette[i:i + 8])
+                            + ',\n')
+                f.write('};\n\n')
+
+            f.write('static uint8_t const %s_Data[%u] = {\n' % (name, len(data)))
+            for i in range(0, len(data), 12):
+                f.write('        ' + ', '.join('0x%02X' % b for b in data[i:i + 12]) + ',\n')
+            f.write('};\n\n')
+
+            f.write('const sprite_t Sprite_%s = { %u, // Width\n' % (name, width))
+            f.write('        %u, // Height\n' % height)
+            f.write('        SPRITE_%s, // Format\n' % fmt.upper())
+            f.write('        %u, // Palette size\n' % len(palette))
+            f.write('        %s, %s_Data, %u };\n'
+                    % ('%s_Palette' % name if palette else '(void*) 0', name, len(data)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert PNGs to ST7789 sprites.')
+    parser.add_argument('png', nargs='+')
+    parser.add_argument('--format', choices=FORMATS, help='force a format for every sprite')
+    parser.add_argument('--background', default='0x0000',
+                        help='BGR565 color for transparent pixels')
+    parser.add_argument('--source', default='MultimodDrivers/src/spritelibrary.c')
+    parser.add_argument('--header', default='MultimodDrivers/spritelibrary.h')
+    args = parser.parse_args()
+
+    background = int(args.background, 0)
+    sprites = []
+
+    for path in args.png:
+        width, height, rows = read_png(path)
+        pixels = [to_bgr565(p, background) for row in reversed(rows) for p in row]
+        fmt, palette, data = encode(pixels, args.format)
+        name = sprite_name(path)
+        sprites.append((name, os.path.basename(path), width, height, fmt, palette, data))
+        print('Sprite_%s: %ux%u %s, %u bytes (%u raw)'
+              % (name, width, height, fmt, len(data) + 2 * len(palette), width * height * 2))
+
+    write_header(args.header, [s[0] for s in sprites])
+    write_source(args.source, sprites)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,10 @@
+// hw_gpio.h
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-26
+// Host stand-in for the TivaWare header, the ST7789 driver includes it but
+// uses nothing from it.
+
+#ifndef __HW_GPIO_H__
+#define __HW_GPIO_H__
+
+#endif // __HW_GPIO_H__
@@ -0,0 +1,15 @@
+// hw_memmap.h
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-26
+// Host stand-in for the TivaWare header, only the bases the ST7789 driver
+// uses. The emulator tells peripherals apart by these values.
+
+#ifndef __HW_MEMMAP_H__
+#define __HW_MEMMAP_H__
+
+#define GPIO_PORTA_BASE         0x40004000
+#define GPIO_PORTC_BASE         0x40006000
+#define GPIO_PORTF_BASE         0x40025000
+#define SSI0_BASE               0x40008000
+
+#endif // __HW_MEMMAP_H__
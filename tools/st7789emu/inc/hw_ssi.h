@@ -0,0 +1,19 @@
+// hw_ssi.h
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-27
+// Host stand-in for the TivaWare header, only the registers and fields
+// multimod_spi.c uses.
+
+#ifndef __HW_SSI_H__
+#define __HW_SSI_H__
+
+#define SSI_O_CR0               0x00000000  // SSI Control 0
+#define SSI_O_DR                0x00000008  // SSI Data
+#define SSI_O_CPSR              0x00000010  // SSI Clock Prescale
+
+#define SSI_CR0_SCR_M           0x0000FF00  // SSI Serial Clock Rate
+#define SSI_CR0_SCR_S           8
+#define SSI_CR0_DSS_M           0x0000000F  // SSI Data Size Select
+#define SSI_CPSR_CPSDVSR_M      0x000000FF  // SSI Clock Prescale Divisor
+
+#endif // __HW_SSI_H__
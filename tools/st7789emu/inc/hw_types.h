@@ -0,0 +1,16 @@
+// hw_types.h
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-27
+// Host stand-in for the TivaWare header. HWREG goes to the emulator's
+// registers instead of the memory map, see Emu_Register.
+
+#ifndef __HW_TYPES_H__
+#define __HW_TYPES_H__
+
+#include <stdint.h>
+
+volatile uint32_t* Emu_Register(uint32_t address);
+
+#define HWREG(x)                (*Emu_Register(x))
+
+#endif // __HW_TYPES_H__
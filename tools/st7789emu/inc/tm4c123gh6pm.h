@@ -0,0 +1,12 @@
+// tm4c123gh6pm.h
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-27
+// Host stand-in for the TivaWare header, only the interrupt multimod_spi.c
+// registers its uDMA handler on.
+
+#ifndef __TM4C123GH6PM_H__
+#define __TM4C123GH6PM_H__
+
+#define INT_SSI0                23          // SSI0
+
+#endif // __TM4C123GH6PM_H__
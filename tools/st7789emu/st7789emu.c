@@ -0,0 +1,872 @@
+// st7789emu.c
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-27
+// Host emulator of the ST7789 behind multimod_ST7789.c and multimod_spi.c.
+// Frames written to the stand-in SSI are split into bytes and decoded like
+// the panel's serial interface does: CASET, RASET, RAMWR(C), MADCTL, COLMOD, VSCRDEF,
+// VSCRSADD, PTLAR, the display mode commands and SWRESET change state,
+// everything else is only counted.
+// RAMRD is answered after one dummy clock, 3 bytes per pixel. Pixel data
+// written faster than the panel's fastest write clock has its low bit
+// flipped, so the driver's clock probe has something to find. Commands and
+// their parameters sent faster than the datasheet's write cycle allows are
+// counted as errors, there is no reading those back.
+// Frames of any size are shifted into bytes, so 12-bit frames pack two
+// RGB444 pixels into three bytes like on the wire.
+// The SSI's registers sit behind HWREG, so the real SPI_ functions run
+// against it. Its uDMA TX channel runs ping-pong transfers into the SSI and
+// calls the handler multimod_spi.c registered as its done interrupt.
+
+/************************************Includes***************************************/
+
+#include "st7789emu.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <inc/hw_types.h>
+#include <inc/hw_memmap.h>
+#include <inc/hw_ssi.h>
+
+#include <driverlib/gpio.h>
+#include <driverlib/sysctl.h>
+#include <driverlib/ssi.h>
+#include <driverlib/udma.h>
+#include <driverlib/cpu.h>
+
+#include "multimod_ST7789.h"
+#include "multimod_spi.h"
+
+#include "../../G8RTOS/G8RTOS_Semaphores.h"
+#include "../../G8RTOS/G8RTOS_Scheduler.h"
+
+/************************************Includes***************************************/
+
+/*************************************Defines***************************************/
+
+// MADCTL bits
+#define EMU_MADCTL_MY           0x80
+#define EMU_MADCTL_MX           0x40
+#define EMU_MADCTL_MV           0x20
+#define EMU_MADCTL_BGR          0x08
+
+// COLMOD interface formats, low 3 bits
+#define EMU_COLMOD_12BIT        0x03
+#define EMU_COLMOD_18BIT        0x06
+
+// SSI receive FIFO depth, frames received while it is full are lost
+#define EMU_RX_FIFO             8
+
+/*************************************Defines***************************************/
+
+/******************************Data Type Definitions********************************/
+
+// uDMA channel control structure, primary or alternate
+typedef struct emuDMAStruct_t
+{
+    uint32_t mode;
+    uint32_t control;
+    const uint8_t *source;
+    uintptr_t destination;
+    uint32_t items;
+} emuDMAStruct_t;
+
+/******************************Data Type Definitions********************************/
+
+/*******************************Private Variables***********************************/
+
+static uint16_t memory[EMU_ROWS][EMU_COLUMNS];
+static emuCounters_t counters;
+
+// pins and SSI, bits shifted in but not a whole byte yet
+static bool selected = false;
+static bool data = false;
+static uint8_t frameSize = 8;
+static uint32_t shiftBits;
+static uint8_t shiftCount;
+
+// SSI0 registers behind HWREG, frame size and SCK are taken from them when
+// the module is enabled. Other addresses all go to one scratch register.
+static uint32_t ssiRegisters[0x1000 / 4];
+static uint32_t otherRegister;
+static bool ssiEnabled = true;
+static uint16_t rxFifo[EMU_RX_FIFO];
+static uint8_t rxCount;
+
+// uDMA channel of the SSI0 TX FIFO, and the interrupt its done signal
+// runs. The alternate structure is in use while alternate is set.
+static emuDMAStruct_t dmaStructs[2];
+static bool dmaEnabled, dmaAlternate, dmaRunning;
+static emuDMAInterrupt_t dmaInterrupt = EMU_DMA_PROMPT;
+static void (*dmaHandler)(void);
+
+// command being received
+static uint8_t command = ST7789_NOP_ADDR;
+static bool haveCommand = false;
+static uint8_t params[6];
+static uint8_t paramCount;
+
+// registers
+static uint16_t xs, xe, ys, ye;
+static uint8_t madctl, colmod;
+static uint16_t scrollTop, scrollHeight, scrollBottom, scrollStart;
+static uint16_t partialStart, partialEnd;
+static bool partial, idle, asleep;
+
+// RAMWR write position, and the bytes of pixels not complete yet
+static uint16_t cx, cy;
+static bool inWindow = false;
+static uint8_t pixelBytes[3];
+static uint8_t pixelCount;
+
+// RAMRD, bits waiting to go out on MISO
+static bool reading = false;
+static uint32_t readBits;
+static uint8_t readCount;
+
+// SCK, the fastest the panel takes and time on the bus not yet counted
+static uint32_t sckHz = SPI_A_CLOCK_HZ;
+static uint32_t maxWriteHz = EMU_MAX_WRITE_HZ;
+static uint64_t wireNs;
+
+// time spent in SysCtlDelay since the counters were last taken
+static uint64_t delayNs;
+
+/*******************************Private Variables***********************************/
+
+/********************************Private Functions**********************************/
+
+// Emu_MemoryAddress
+// Maps a column and row address to frame memory through MADCTL.
+// Return: bool, false if outside of frame memory
+static bool Emu_MemoryAddress(uint16_t x, uint16_t y, uint16_t *column, uint16_t *row)
+{
+    if (madctl & EMU_MADCTL_MV)
+    {
+        uint16_t t = x;
+        x = y;
+        y = t;
+    }
+
+    if (x >= EMU_COLUMNS || y >= EMU_ROWS)
+        return false;
+
+    *column = madctl & EMU_MADCTL_MX ? EMU_COLUMNS - 1 - x : x;
+    *row = madctl & EMU_MADCTL_MY ? EMU_ROWS - 1 - y : y;
+    return true;
+}
+
+// Emu_Widen444
+// Widens an RGB444 pixel to the RGB565 kept in frame memory.
+static uint16_t Emu_Widen444(uint16_t pixel)
+{
+    uint16_t r = pixel >> 8 & 0xF, g = pixel >> 4 & 0xF, b = pixel & 0xF;
+
+    return (r << 1 | r >> 3) << 11 | (g << 2 | g >> 2) << 5 | (b << 1 | b >> 3);
+}
+
+// Emu_Pixel
+// Writes a pixel at the RAMWR position and moves it on, wrapping within
+// the window.
+static void Emu_Pixel(uint16_t color)
+{
+    uint16_t column, row;
+
+    if (!inWindow)
+    {
+        counters.errors++;
+        return;
+    }
+
+    if (Emu_MemoryAddress(cx, cy, &column, &row))
+        memory[row][column] = color;
+
+    counters.pixels++;
+
+    if (++cx > xe)
+    {
+        cx = xs;
+        if (++cy > ye)
+            cy = ys;
+    }
+}
+
+// Emu_Command
+// Starts a command. Commands without parameters take effect here.
+static void Emu_Command(uint8_t byte)
+{
+    command = byte;
+    haveCommand = true;
+    paramCount = 0;
+    pixelCount = 0;
+    inWindow = false;
+    reading = false;
+    counters.commands++;
+
+    switch (command)
+    {
+    case ST7789_SWRESET_ADDR:
+        xs = ys = 0;
+        xe = EMU_COLUMNS - 1;
+        ye = EMU_ROWS - 1;
+        madctl = 0;
+        colmod = 0x66;
+        scrollTop = scrollBottom = scrollStart = 0;
+        scrollHeight = EMU_ROWS;
+        partialStart = 0;
+        partialEnd = EMU_ROWS - 1;
+        partial = idle = false;
+        asleep = true;
+        break;
+    case ST7789_SLPIN_ADDR:
+    case ST7789_SLPOUT_ADDR:
+        asleep = command == ST7789_SLPIN_ADDR;
+        break;
+    case ST7789_PLTON_ADDR:
+    case ST7789_NORON_ADDR:
+        partial = command == ST7789_PLTON_ADDR;
+        break;
+    case ST7789_IDMON_ADDR:
+    case ST7789_IDMOFF_ADDR:
+        idle = command == ST7789_IDMON_ADDR;
+        break;
+    case ST7789_RAMWR_ADDR:
+        cx = xs;
+        cy = ys;
+        inWindow = true;
+        counters.windows++;
+        break;
+    case ST7789_RAMWRC_ADDR:
+        inWindow = true;
+        break;
+    case ST7789_RAMRD_ADDR:
+        cx = xs;
+        cy = ys;
+        reading = true;
+        readBits = 0;
+        readCount = 1;
+        break;
+    }
+}
+
+// Emu_Param
+// Takes a parameter byte of the current command.
+static void Emu_Param(uint8_t byte)
+{
+    if (!haveCommand)
+    {
+        counters.errors++;
+        return;
+    }
+
+    if (command == ST7789_RAMWR_ADDR || command == ST7789_RAMWRC_ADDR)
+    {
+        pixelBytes[pixelCount++] = byte;
+
+        if ((colmod & 0x07) == EMU_COLMOD_12BIT)
+        {
+            // two pixels in three bytes, 4 bits per field. The first is
+            // written once the byte holding its last field is complete.
+            if (pixelCount == 2)
+            {
+                Emu_Pixel(Emu_Widen444(pixelBytes[0] << 4 | pixelBytes[1] >> 4));
+            }
+            else if (pixelCount == 3)
+            {
+                Emu_Pixel(Emu_Widen444((pixelBytes[1] & 0x0F) << 8 | pixelBytes[2]));
+                pixelCount = 0;
+            }
+        }
+        else if ((colmod & 0x07) == EMU_COLMOD_18BIT)
+        {
+            // one pixel in three bytes, 6 bits per field in the high bits
+            if (pixelCount == 3)
+            {
+                Emu_Pixel((pixelBytes[0] >> 3) << 11 | (pixelBytes[1] >> 2) << 5
+                          | pixelBytes[2] >> 3);
+                pixelCount = 0;
+            }
+        }
+        else if (pixelCount == 2)
+        {
+            Emu_Pixel(pixelBytes[0] << 8 | pixelBytes[1]);
+            pixelCount = 0;
+        }
+        return;
+    }
+
+    if (paramCount < sizeof(params))
+        params[paramCount++] = byte;
+
+    switch (command)
+    {
+    case ST7789_CASET_ADDR:
+        if (paramCount == 4)
+        {
+            xs = params[0] << 8 | params[1];
+            xe = params[2] << 8 | params[3];
+            counters.caset++;
+        }
+        break;
+    case ST7789_RASET_ADDR:
+        if (paramCount == 4)
+        {
+            ys = params[0] << 8 | params[1];
+            ye = params[2] << 8 | params[3];
+            counters.raset++;
+        }
+        break;
+    case ST7789_MADCTL_ADDR:
+        madctl = params[0];
+        break;
+    case ST7789_COLMOD_ADDR:
+        colmod = params[0];
+        break;
+    case ST7789_VSCRDEF_ADDR:
+        if (paramCount == 6)
+        {
+            scrollTop = params[0] << 8 | params[1];
+            scrollHeight = params[2] << 8 | params[3];
+            scrollBottom = params[4] << 8 | params[5];
+        }
+        break;
+    case ST7789_VSCRSADD_ADDR:
+        if (paramCount == 2)
+            scrollStart = params[0] << 8 | params[1];
+        break;
+    case ST7789_PTLAR_ADDR:
+        if (paramCount == 4)
+        {
+            partialStart = params[0] << 8 | params[1];
+            partialEnd = params[2] << 8 | params[3];
+        }
+        break;
+    }
+}
+
+// Emu_Clock
+// Counts a byte on the bus and the time it took.
+static void Emu_Clock(void)
+{
+    counters.bytes++;
+    wireNs += 8000000000ULL / sckHz;
+}
+
+// Emu_Byte
+// One byte on MOSI, DC decides if it is a command or a parameter.
+static void Emu_Byte(uint8_t byte)
+{
+    Emu_Clock();
+
+    if (data && (command == ST7789_RAMWR_ADDR || command == ST7789_RAMWRC_ADDR))
+    {
+        if (sckHz > maxWriteHz)
+            byte ^= 0x01;
+        Emu_Param(byte);
+        return;
+    }
+
+    if (sckHz > EMU_MAX_COMMAND_HZ)
+        counters.errors++;
+
+    if (data)
+        Emu_Param(byte);
+    else
+        Emu_Command(byte);
+}
+
+// Emu_ReadByte
+// One byte on MISO, shifted in while a byte goes out on MOSI. RAMRD sends
+// 6 bits per field in the high bits of a byte, after a one bit dummy clock.
+static uint8_t Emu_ReadByte(void)
+{
+    if (!selected || !reading)
+        return 0;
+
+    if (readCount < 8)
+    {
+        uint16_t column, row, c = 0;
+
+        if (Emu_MemoryAddress(cx, cy, &column, &row))
+            c = memory[row][column];
+
+        readBits = readBits << 24 | (uint32_t) (c >> 11) << 19 | (uint32_t) (c >> 5 & 0x3F) << 10
+                | (uint32_t) (c & 0x1F) << 3;
+        readCount += 24;
+
+        if (++cx > xe)
+        {
+            cx = xs;
+            if (++cy > ye)
+                cy = ys;
+        }
+    }
+
+    readCount -= 8;
+    return readBits >> readCount & 0xFF;
+}
+
+// Emu_Frame
+// One SSI frame, shifted out MSB first. The panel takes the bits a byte at
+// a time, whatever the frame size. What comes back on MISO goes to the
+// receive FIFO, reads are only modelled with 8-bit frames.
+static void Emu_Frame(uint16_t value)
+{
+    uint8_t miso = 0;
+
+    if (!selected || !ssiEnabled)
+    {
+        counters.errors++;
+        return;
+    }
+
+    shiftBits = shiftBits << frameSize | (value & ((1u << frameSize) - 1));
+    shiftCount += frameSize;
+
+    while (shiftCount >= 8)
+    {
+        shiftCount -= 8;
+        miso = Emu_ReadByte();
+        Emu_Byte(shiftBits >> shiftCount & 0xFF);
+    }
+
+    if (rxCount < EMU_RX_FIFO)
+        rxFifo[rxCount++] = frameSize == 8 ? miso : 0;
+}
+
+// Emu_DMARun
+// Runs the uDMA channel until it stops. Each control structure moves its
+// items into the SSI data register, then stops and hands over to the other
+// one, which the channel stops at if it was stopped too. The done
+// interrupt runs after every structure, only once the channel stopped, or
+// not at all, as set with Emu_SetDMAInterrupt. The handler re-arming the
+// channel from the interrupt just keeps this loop going.
+static void Emu_DMARun(void)
+{
+    if (dmaRunning)
+        return;
+
+    dmaRunning = true;
+    while (dmaEnabled)
+    {
+        emuDMAStruct_t *d = &dmaStructs[dmaAlternate];
+        uint8_t size = (d->control & UDMA_SIZE_16) == UDMA_SIZE_16 ? 2 : 1;
+        bool increment = (d->control & UDMA_SRC_INC_NONE) != UDMA_SRC_INC_NONE;
+
+        if (d->mode != UDMA_MODE_PINGPONG || !d->items || d->items > SPI_DMA_MAX_ITEMS
+                || d->destination != SSI0_BASE + SSI_O_DR)
+            counters.errors++;
+
+        for (uint32_t i = 0; i < d->items; i++)
+        {
+            const uint8_t *item = d->source + (increment ? i * size : 0);
+
+            // items are read little endian, like the Cortex-M4 does
+            Emu_Frame(size == 2 ? item[0] | item[1] << 8 : item[0]);
+        }
+
+        counters.dmaStructs++;
+        d->mode = UDMA_MODE_STOP;
+        dmaAlternate = !dmaAlternate;
+        if (dmaStructs[dmaAlternate].mode == UDMA_MODE_STOP)
+            dmaEnabled = false;
+
+        if (dmaHandler && !CPUprimask()
+                && (dmaInterrupt == EMU_DMA_PROMPT || (dmaInterrupt == EMU_DMA_LATE && !dmaEnabled)))
+            dmaHandler();
+    }
+    dmaRunning = false;
+}
+
+/********************************Private Functions**********************************/
+
+/********************************Public Functions***********************************/
+
+// Emu_Reset
+// Power on state, frame memory is black and counters are cleared.
+// Return: void
+void Emu_Reset(void)
+{
+    memset(memory, 0, sizeof(memory));
+    memset(&counters, 0, sizeof(counters));
+    selected = false;
+    data = false;
+    shiftCount = 0;
+    haveCommand = false;
+    wireNs = 0;
+    delayNs = 0;
+
+    // 8-bit frames at SPI_A_CLOCK_HZ, as SPI_Init leaves them
+    memset(ssiRegisters, 0, sizeof(ssiRegisters));
+    SSIConfigSetExpClk(SSI0_BASE, SysCtlClockGet(), SSI_FRF_MOTO_MODE_3, SSI_MODE_MASTER,
+                       SPI_A_CLOCK_HZ, 8);
+    SSIEnable(SSI0_BASE);
+    rxCount = 0;
+
+    memset(dmaStructs, 0, sizeof(dmaStructs));
+    dmaEnabled = dmaAlternate = false;
+
+    Emu_Command(ST7789_SWRESET_ADDR);
+    haveCommand = false;
+    memset(&counters, 0, sizeof(counters));
+}
+
+// Emu_SetDMAInterrupt
+// Sets when the uDMA done interrupt runs, EMU_DMA_PROMPT after start.
+// Param emuDMAInterrupt_t "when": when the interrupt runs
+// Return: void
+void Emu_SetDMAInterrupt(emuDMAInterrupt_t when)
+{
+    dmaInterrupt = when;
+}
+
+// Emu_Register
+// Register HWREG accesses at an address, see hw_types.h.
+// Param uint32_t "address": register address
+// Return: volatile uint32_t*
+volatile uint32_t* Emu_Register(uint32_t address)
+{
+    if (address >= SSI0_BASE && address < SSI0_BASE + sizeof(ssiRegisters))
+        return &ssiRegisters[(address - SSI0_BASE) / 4];
+
+    return &otherRegister;
+}
+
+// Emu_SetMaxWriteClock
+// Sets the fastest SCK the panel takes pixel data at, EMU_MAX_WRITE_HZ
+// after start.
+// Param uint32_t "hz": write clock limit
+// Return: void
+void Emu_SetMaxWriteClock(uint32_t hz)
+{
+    maxWriteHz = hz;
+}
+
+// Emu_TakeCounters
+// Copies the counters and starts counting again.
+// Param emuCounters_t* "out": counters since the last call
+// Return: void
+void Emu_TakeCounters(emuCounters_t *out)
+{
+    counters.wireUs = wireNs / 1000;
+    wireNs %= 1000;
+    counters.delayUs = delayNs / 1000;
+    delayNs %= 1000;
+    *out = counters;
+    memset(&counters, 0, sizeof(counters));
+}
+
+// Emu_WireTimeUs
+// Time the counted bytes took on the bus, ignoring gaps.
+// Param emuCounters_t* "c": counters
+// Return: uint32_t, us
+uint32_t Emu_WireTimeUs(const emuCounters_t *c)
+{
+    return c->wireUs;
+}
+
+// Emu_GetPixel
+// Gets the pixel the driver would address at x, y.
+// Param uint16_t "x": column address
+// Param uint16_t "y": row address
+// Return: uint16_t, 0 outside of frame memory
+uint16_t Emu_GetPixel(uint16_t x, uint16_t y)
+{
+    uint16_t column, row;
+
+    return Emu_MemoryAddress(x, y, &column, &row) ? memory[row][column] : 0;
+}
+
+// Emu_WritePPM
+// Writes what the panel shows as a binary PPM. Lines in the scroll band
+// come from the scrolled frame memory line. In partial mode lines outside
+// the partial area are black, asleep all of them are, and idle mode keeps
+// the top bit of each field. The panel is mounted upside down, so the
+// image is turned around.
+// Param char* "path": file to write
+// Return: int, 1 on success
+int Emu_WritePPM(const char *path)
+{
+    FILE *f = fopen(path, "wb");
+
+    if (!f)
+        return 0;
+
+    fprintf(f, "P6\n%d %d\n255\n", EMU_COLUMNS, EMU_ROWS);
+    for (int line = EMU_ROWS - 1; line >= 0; line--)
+    {
+        int row = line;
+        bool shown = !asleep;
+
+        if (scrollHeight && line >= scrollTop && line < scrollTop + scrollHeight)
+            row = scrollTop + (line - scrollTop + scrollStart - scrollTop) % scrollHeight;
+
+        // the partial area wraps around when it ends above where it starts
+        if (partial && partialStart <= partialEnd)
+            shown = shown && line >= partialStart && line <= partialEnd;
+        else if (partial)
+            shown = shown && (line >= partialStart || line <= partialEnd);
+
+        for (int column = EMU_COLUMNS - 1; column >= 0; column--)
+        {
+            uint16_t c = shown ? memory[row][column] : 0;
+
+            if (idle)
+            {
+                c = (c & 0x8000 ? 0xF800 : 0) | (c & 0x0400 ? 0x07E0 : 0)
+                        | (c & 0x0010 ? 0x001F : 0);
+            }
+            uint8_t r = (c >> 11) << 3, g = ((c >> 5) & 0x3F) << 2, b = (c & 0x1F) << 3;
+            uint8_t rgb[3] = { r, g, b };
+
+            if (madctl & EMU_MADCTL_BGR)
+            {
+                rgb[0] = b;
+                rgb[2] = r;
+            }
+            fwrite(rgb, 1, 3, f);
+        }
+    }
+
+    fclose(f);
+    return 1;
+}
+
+/********************************Public Functions***********************************/
+
+/******************************Hardware Stand-ins***********************************/
+
+void GPIOPinWrite(uint32_t ui32Port, uint8_t ui8Pins, uint8_t ui8Val)
+{
+    if (ui32Port != ST7789_PIN_PORT_BASE)
+        return;
+
+    counters.gpioWrites++;
+
+    if (ui8Pins & ST7789_CS_PIN)
+    {
+        bool select = !(ui8Val & ST7789_CS_PIN);
+
+        // CS high resets the serial interface, a half sent pixel is lost
+        if (select && !selected)
+            counters.selects++;
+        if (!select)
+        {
+            pixelCount = 0;
+            if (shiftCount)
+                counters.errors++;
+            shiftCount = 0;
+        }
+        selected = select;
+    }
+
+    if (ui8Pins & ST7789_DC_PIN)
+    {
+        bool level = ui8Val & ST7789_DC_PIN;
+
+        // DC is sampled with the last bit of each byte
+        if (level != data && shiftCount)
+            counters.errors++;
+        if (level != data)
+            counters.dcToggles++;
+        data = level;
+    }
+}
+
+void GPIOPinTypeGPIOOutput(uint32_t ui32Port, uint8_t ui8Pins)
+{
+}
+
+void SysCtlPeripheralEnable(uint32_t ui32Peripheral)
+{
+}
+
+// counts the time the loop would take, 3 cycles per count
+void SysCtlDelay(uint32_t ui32Count)
+{
+    delayNs += ui32Count * 3000000000ULL / SysCtlClockGet();
+}
+
+uint32_t SysCtlClockGet(void)
+{
+    return 80000000;
+}
+
+// one thread on the host
+tcb_t *CurrentlyRunningThread;
+
+void G8RTOS_WaitSemaphore(semaphore_t *s)
+{
+    (*s)--;
+}
+
+void G8RTOS_SignalSemaphore(semaphore_t *s)
+{
+    (*s)++;
+}
+
+void G8RTOS_InitSemaphore(semaphore_t *s, int32_t value)
+{
+    *s = value;
+}
+
+sched_ErrCode_t G8RTOS_AddAperiodicEvent(void (*threadToAdd)(void), uint8_t threadPriority,
+                                         int32_t IRQn)
+{
+    // the only interrupt is the uDMA done signal on the SSI vector
+    dmaHandler = threadToAdd;
+    return NO_ERROR;
+}
+
+// the done interrupt only runs while interrupts are on, see
+// Emu_SetDMAInterrupt
+uint32_t CPUprimask(void)
+{
+    return dmaInterrupt == EMU_DMA_POLLED;
+}
+
+void GPIOPinConfigure(uint32_t ui32PinConfig)
+{
+}
+
+void GPIOPinTypeSSI(uint32_t ui32Port, uint8_t ui8Pins)
+{
+}
+
+bool SysCtlPeripheralReady(uint32_t ui32Peripheral)
+{
+    return true;
+}
+
+void SSIConfigSetExpClk(uint32_t ui32Base, uint32_t ui32SSIClk, uint32_t ui32Protocol,
+                        uint32_t ui32Mode, uint32_t ui32BitRate, uint32_t ui32DataWidth)
+{
+    uint32_t maxBitRate = ui32SSIClk / ui32BitRate, prescale = 0, scr;
+
+    // as TivaWare picks the dividers
+    do
+    {
+        prescale += 2;
+        scr = maxBitRate / prescale - 1;
+    } while (scr > 255);
+
+    HWREG(ui32Base + SSI_O_CPSR) = prescale;
+    HWREG(ui32Base + SSI_O_CR0) = scr << SSI_CR0_SCR_S | (ui32DataWidth - 1);
+}
+
+void SSIClockSourceSet(uint32_t ui32Base, uint32_t ui32Source)
+{
+}
+
+void SSIDisable(uint32_t ui32Base)
+{
+    ssiEnabled = false;
+}
+
+// frame size and SCK only change with the module disabled, so they are
+// taken from the registers here
+void SSIEnable(uint32_t ui32Base)
+{
+    uint32_t cr0 = HWREG(ui32Base + SSI_O_CR0);
+    uint32_t prescale = HWREG(ui32Base + SSI_O_CPSR) & SSI_CPSR_CPSDVSR_M;
+    uint8_t bits = (cr0 & SSI_CR0_DSS_M) + 1;
+
+    if (bits != frameSize)
+        counters.frameSizeChanges++;
+    frameSize = bits;
+    sckHz = SysCtlClockGet() / ((prescale ? prescale : 2)
+            * (1 + ((cr0 & SSI_CR0_SCR_M) >> SSI_CR0_SCR_S)));
+    ssiEnabled = true;
+}
+
+void SSIDMAEnable(uint32_t ui32Base, uint32_t ui32DMAFlags)
+{
+}
+
+// frames go straight out, so the SSI is never busy
+bool SSIBusy(uint32_t ui32Base)
+{
+    return false;
+}
+
+void SSIDataPut(uint32_t ui32Base, uint32_t ui32Data)
+{
+    Emu_Frame(ui32Data);
+}
+
+int32_t SSIDataGetNonBlocking(uint32_t ui32Base, uint32_t *pui32Data)
+{
+    if (!rxCount)
+        return 0;
+
+    *pui32Data = rxFifo[0];
+    memmove(rxFifo, rxFifo + 1, --rxCount * sizeof(rxFifo[0]));
+    return 1;
+}
+
+// would wait forever on an empty FIFO
+void SSIDataGet(uint32_t ui32Base, uint32_t *pui32Data)
+{
+    if (!SSIDataGetNonBlocking(ui32Base, pui32Data))
+    {
+        counters.errors++;
+        *pui32Data = 0;
+    }
+}
+
+void uDMAEnable(void)
+{
+}
+
+void uDMAControlBaseSet(void *pControlTable)
+{
+}
+
+void uDMAChannelAssign(uint32_t ui32Mapping)
+{
+}
+
+void uDMAChannelAttributeDisable(uint32_t ui32ChannelNum, uint32_t ui32Attr)
+{
+    if (ui32Attr & UDMA_ATTR_ALTSELECT)
+        dmaAlternate = false;
+}
+
+void uDMAChannelControlSet(uint32_t ui32ChannelStructIndex, uint32_t ui32Control)
+{
+    dmaStructs[(ui32ChannelStructIndex & UDMA_ALT_SELECT) != 0].control = ui32Control;
+}
+
+void uDMAChannelTransferSet(uint32_t ui32ChannelStructIndex, uint32_t ui32Mode,
+                            void *pvSrcAddr, void *pvDstAddr, uint32_t ui32TransferSize)
+{
+    emuDMAStruct_t *d = &dmaStructs[(ui32ChannelStructIndex & UDMA_ALT_SELECT) != 0];
+
+    d->mode = ui32Mode;
+    d->source = pvSrcAddr;
+    d->destination = (uintptr_t) pvDstAddr;
+    d->items = ui32TransferSize;
+}
+
+uint32_t uDMAChannelModeGet(uint32_t ui32ChannelStructIndex)
+{
+    return dmaStructs[(ui32ChannelStructIndex & UDMA_ALT_SELECT) != 0].mode;
+}
+
+void uDMAChannelEnable(uint32_t ui32ChannelNum)
+{
+    counters.dmaStarts++;
+    dmaEnabled = true;
+    Emu_DMARun();
+}
+
+bool uDMAChannelIsEnabled(uint32_t ui32ChannelNum)
+{
+    return dmaEnabled;
+}
+
+void uDMAIntClear(uint32_t ui32ChanMask)
+{
+}
+
+/******************************Hardware Stand-ins***********************************/
@@ -0,0 +1,100 @@
+// st7789emu.h
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-27
+// Host emulator of the ST7789 behind multimod_ST7789.c and multimod_spi.c.
+// Stands in for the SSI, uDMA, GPIO, SysCtl and semaphore calls the drivers
+// make, decodes the command stream into frame memory, answers RAMRD and
+// counts what was sent.
+
+#ifndef ST7789EMU_H_
+#define ST7789EMU_H_
+
+/************************************Includes***************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/************************************Includes***************************************/
+
+/*************************************Defines***************************************/
+
+// Frame memory of the ST7789, the panel shows 240 x 320 of it
+#define EMU_COLUMNS             240
+#define EMU_ROWS                320
+
+// Fastest write clock the emulated panel takes by default, above it pixel
+// data is garbled
+#define EMU_MAX_WRITE_HZ        20000000
+
+// Fastest SCK commands and parameters are taken at, a 66 ns write cycle
+#define EMU_MAX_COMMAND_HZ      15151515
+
+/*************************************Defines***************************************/
+
+/******************************Data Type Definitions********************************/
+
+// When the uDMA done interrupt runs
+typedef enum
+{
+    // after each control structure, so the handler re-arms it while the
+    // other one runs
+    EMU_DMA_PROMPT = 0,
+    // only after the channel stopped, both structures ran dry first
+    EMU_DMA_LATE = 1,
+    // never, interrupts are off and SPI_DMA_Handler is polled
+    EMU_DMA_POLLED = 2
+} emuDMAInterrupt_t;
+
+/******************************Data Type Definitions********************************/
+
+/****************************Data Structure Definitions*****************************/
+
+/*
+ *  Emulator Counters:
+ *      - Bytes are everything shifted out while CS is low, commands are
+ *        the bytes sent with DC low
+ *      - Windows counts RAMWR, CASET and RASET count address changes
+ *      - Errors are frames sent while deselected, data without a command,
+ *        pixels sent with no window and bits left over at deselect or at
+ *        a DC change
+ *      - wireUs is the time the bytes took at the SCK they were sent at,
+ *        delayUs the time SysCtlDelay spun for
+ *      - gpioWrites counts CS and DC pin writes, dcToggles the writes that
+ *        changed DC
+ *      - dmaStarts counts uDMA channel enables, dmaStructs the control
+ *        structures it ran
+ * */
+typedef struct emuCounters_t
+{
+    uint32_t bytes;
+    uint32_t commands;
+    uint32_t windows;
+    uint32_t caset;
+    uint32_t raset;
+    uint32_t pixels;
+    uint32_t selects;
+    uint32_t frameSizeChanges;
+    uint32_t errors;
+    uint32_t wireUs;
+    uint32_t delayUs;
+    uint32_t gpioWrites;
+    uint32_t dcToggles;
+    uint32_t dmaStarts;
+    uint32_t dmaStructs;
+} emuCounters_t;
+
+/****************************Data Structure Definitions*****************************/
+
+/********************************Public Functions***********************************/
+
+void Emu_Reset(void);
+void Emu_SetMaxWriteClock(uint32_t hz);
+void Emu_SetDMAInterrupt(emuDMAInterrupt_t when);
+void Emu_TakeCounters(emuCounters_t *counters);
+uint32_t Emu_WireTimeUs(const emuCounters_t *counters);
+uint16_t Emu_GetPixel(uint16_t x, uint16_t y);
+int Emu_WritePPM(const char *path);
+
+/********************************Public Functions***********************************/
+
+#endif /* ST7789EMU_H_ */
@@ -0,0 +1,747 @@
+// st7789emu_main.c
+// Date Created: 2023-07-26
+// Date Updated: 2023-07-27
+// Host tool, runs the real multimod_ST7789.c and multimod_spi.c against the
+// emulated panel.
+// Given a trace from DisplayList_SetTrace, every list is optimized, ordered and
+// drawn through the driver like DisplayList_Render would, and what each
+// frame cost on the bus is printed, each list sent as one batch like the
+// render thread does (-u sends every op on its own, -4 draws in RGB444).
+// -m replays the trace a second time from reset the other way, batched or
+// not, and checks every frame came out the same. Without a trace a fixed scene is drawn
+// and the cost of each driver call is printed instead, in both RGB565 and
+// RGB444 mode, and the uDMA transfers of multimod_spi.c are checked with
+// the done interrupt coming early, late and not at all, then the time from
+// reset to the game's first list is measured with the board drawn as rects
+// and as the pattern fill. The write clock is
+// probed after init like on the board, against a panel that takes at most
+// -c Hz (EMU_MAX_WRITE_HZ by default).
+//
+// Build from the repository root (-fcommon like the target build, the
+// G8RTOS headers define SystemTime):
+//   cc -std=c99 -fcommon -DPART_TM4C123GH6PM -DDISPLAYLIST_HOST -Itools/st7789emu -I.
+//      -IMultimodDrivers -Itools/dlreplay
+//      -o st7789emu tools/st7789emu/st7789emu.c tools/st7789emu/st7789emu_main.c
+//      tools/dlreplay/dltrace.c boardgrid.c MultimodDrivers/src/multimod_ST7789.c
+//      MultimodDrivers/src/multimod_spi.c
+//      MultimodDrivers/src/multimod_raster.c MultimodDrivers/src/multimod_displaylist.c
+//      MultimodDrivers/src/multimod_compositor.c MultimodDrivers/src/fontlibrary.c
+//      MultimodDrivers/src/glyphcache.c MultimodDrivers/src/spritelibrary.c
+//
+// Usage:
+//   st7789emu [-v] [-u] [-4] [-m] [-c max_write_hz] [-s snapshot_prefix] [-o out.ppm]
+//             [trace.txt]
+//
+// The per frame figures in the history are for the sample trace of
+// dlreplay, tools/dlreplay/sample_trace.txt:
+//   st7789emu tools/dlreplay/sample_trace.txt
+//   st7789emu -u tools/dlreplay/sample_trace.txt
+
+/************************************Includes***************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <driverlib/gpio.h>
+
+#include "st7789emu.h"
+#include "dltrace.h"
+#include "multimod_ST7789.h"
+#include "multimod_spi.h"
+#include "multimod_displaylist.h"
+#include "multimod_compositor.h"
+#include "boardgrid.h"
+
+/************************************Includes***************************************/
+
+/*******************************Private Variables***********************************/
+
+static displayOp_t ops[DISPLAYLIST_MAX_OPS];
+
+// stand-in for untraced bitmap and composition data, big enough for a whole
+// screen
+static uint8_t pattern[X_MAX * Y_MAX * 2];
+
+// stand-in for untraced pattern tiles, the blit pattern repeats every 16
+// pixels both ways
+static uint16_t tile[16 * 16];
+static const st7789Pattern_t tilePattern = { tile, 16, 16, 0 };
+
+// hash of every frame of the first replay, for -m
+#define MAX_HASHED_FRAMES   4096
+static uint32_t frameHashes[MAX_HASHED_FRAMES];
+
+/*******************************Private Variables***********************************/
+
+/********************************Private Functions**********************************/
+
+// PrintCounters
+// One line of counters, with the time the bytes take on the bus.
+static void PrintCounters(const char *name, const emuCounters_t *c)
+{
+    printf("%-16s %8u bytes %6u cmds %5u windows (%u CASET, %u RASET) %7u px %4u sel"
+           " %4u size %5u gpio %4u dc %7u us",
+           name, c->bytes, c->commands, c->windows, c->caset, c->raset, c->pixels, c->selects,
+           c->frameSizeChanges, c->gpioWrites, c->dcToggles, Emu_WireTimeUs(c));
+    if (c->delayUs)
+        printf(" + %u us delays", c->delayUs);
+    if (c->errors)
+        printf(" %u ERRORS", c->errors);
+    printf("\n");
+}
+
+// Accumulate
+// Adds counters into a total and keeps the largest frame.
+static void Accumulate(emuCounters_t *total, emuCounters_t *max, const emuCounters_t *c)
+{
+    const uint32_t *in = (const uint32_t*) c;
+    uint32_t *sum = (uint32_t*) total, *most = (uint32_t*) max;
+
+    for (size_t i = 0; i < sizeof(emuCounters_t) / sizeof(uint32_t); i++)
+    {
+        sum[i] += in[i];
+        if (in[i] > most[i])
+            most[i] = in[i];
+    }
+}
+
+// Pattern
+// Fills the bitmap stand-in with the pattern dlreplay draws for a blit.
+static const uint8_t* Pattern(const displayOp_t *op)
+{
+    uint8_t *p = pattern;
+
+    for (uint32_t y = op->y; y < (uint32_t) op->y + op->h; y++)
+    {
+        for (uint32_t x = op->x; x < (uint32_t) op->x + op->w; x++)
+        {
+            uint16_t c = ((x ^ y) & 8) ? 0x7BEF : 0x39E7;
+
+            *p++ = c >> 8;
+            *p++ = c & 0xFF;
+        }
+    }
+
+    return pattern;
+}
+
+// Tile
+// Fills the pattern tile stand-in with what Pattern draws for the window.
+static const st7789Pattern_t* Tile(const displayOp_t *op)
+{
+    for (uint32_t y = 0; y < 16; y++)
+    {
+        for (uint32_t x = 0; x < 16; x++)
+            tile[y * 16 + x] = (((op->x + x) ^ (op->y + y)) & 8) ? 0x7BEF : 0x39E7;
+    }
+
+    return &tilePattern;
+}
+
+// Execute
+// Draws a list through the driver, like DisplayList_Render.
+static void Execute(const displayOp_t *list, uint16_t count)
+{
+    for (uint16_t i = 0; i < count; i++)
+    {
+        const displayOp_t *op = &list[i];
+
+        switch (op->type)
+        {
+        case DISPLAYLIST_RECT:
+            ST7789_DrawRectangle(op->x, op->y, op->w, op->h, op->color);
+            break;
+        case DISPLAYLIST_OUTLINE:
+            ST7789_DrawOutline(op->x, op->y, op->w, op->h, op->color);
+            break;
+        case DISPLAYLIST_TEXT:
+            ST7789_DrawText(&FontStyle_Emulogic, op->data.text, op->x, op->y, op->color,
+                            op->bgColor);
+            break;
+        case DISPLAYLIST_BLIT:
+        case DISPLAYLIST_COMPOSITE:
+            if ((uint32_t) op->w * op->h * 2 <= sizeof(pattern))
+                ST7789_DrawBitmap(op->x, op->y, op->w, op->h, Pattern(op));
+            break;
+        case DISPLAYLIST_SCROLL:
+            ST7789_SetScrollArea(op->data.scroll.top, op->data.scroll.height);
+            ST7789_SetScrollStart(op->data.scroll.start);
+            break;
+        case DISPLAYLIST_PATTERN:
+            ST7789_FillPattern(op->x, op->y, op->w, op->h, Tile(op));
+            break;
+        case DISPLAYLIST_MODE:
+            if (op->data.mode.mode & ST7789_MODE_PARTIAL)
+                ST7789_SetPartialArea(op->data.mode.top, op->data.mode.height);
+            ST7789_SetMode((st7789Mode_t) op->data.mode.mode);
+            break;
+        }
+    }
+}
+
+// FrameHash
+// FNV-1a hash of the whole frame memory shown.
+static uint32_t FrameHash(void)
+{
+    uint32_t hash = 2166136261u;
+
+    for (uint16_t y = 0; y < Y_MAX; y++)
+    {
+        for (uint16_t x = 0; x < X_MAX; x++)
+        {
+            uint16_t pixel = Emu_GetPixel(x, y);
+
+            hash = (hash ^ (pixel & 0xFF)) * 16777619u;
+            hash = (hash ^ (pixel >> 8)) * 16777619u;
+        }
+    }
+
+    return hash;
+}
+
+// ReplayTrace
+// Draws every list of a trace and prints per frame and total counters.
+// Param int "batch": send each list as one batch, like DisplayList_Render
+// Param int "compare": check each frame against frameHashes instead of
+// recording it there
+// Return: int, number of frames with decode errors or that differ
+static int ReplayTrace(const char *path, const char *snapshots, int verbose, int batch,
+                       int compare)
+{
+    FILE *f = fopen(path, "r");
+    emuCounters_t c, total = { 0 }, max = { 0 };
+    unsigned frames = 0, bad = 0;
+    uint16_t n;
+    char name[32];
+
+    if (!f)
+    {
+        perror(path);
+        return -1;
+    }
+
+    while ((n = DLTrace_ReadList(f, ops)) != DLTRACE_END)
+    {
+        n = DisplayList_Optimize(ops, n);
+        DisplayList_Prioritize(ops, n);
+        if (batch)
+            ST7789_BeginBatch();
+        Execute(ops, n);
+        if (batch)
+            ST7789_EndBatch();
+        Emu_TakeCounters(&c);
+
+        Accumulate(&total, &max, &c);
+        bad += c.errors != 0;
+
+        if (frames < MAX_HASHED_FRAMES && !compare)
+        {
+            frameHashes[frames] = FrameHash();
+        }
+        else if (frames < MAX_HASHED_FRAMES && frameHashes[frames] != FrameHash())
+        {
+            printf("frame %u differs from the %s replay\n", frames,
+                   batch ? "unbatched" : "batched");
+            bad++;
+        }
+
+        if (verbose || c.errors)
+        {
+            snprintf(name, sizeof(name), "frame %u", frames);
+            PrintCounters(name, &c);
+        }
+
+        if (snapshots)
+        {
+            char file[256];
+
+            snprintf(file, sizeof(file), "%s%04u.ppm", snapshots, frames);
+            if (!Emu_WritePPM(file))
+                perror(file);
+        }
+
+        frames++;
+    }
+    fclose(f);
+
+    printf("%u frames\n", frames);
+    PrintCounters("total", &total);
+    PrintCounters("largest", &max);
+    if (frames)
+    {
+        printf("average          %8u bytes %6u cmds %5u windows %4u sel %5u gpio %4u dc %7u us\n",
+               total.bytes / frames, total.commands / frames, total.windows / frames,
+               total.selects / frames, total.gpioWrites / frames, total.dcToggles / frames,
+               Emu_WireTimeUs(&total) / frames);
+    }
+
+    return (int) bad;
+}
+
+// Compose
+// Composes a preview slot holding a piece of four 8x8 blocks, commits it
+// and draws the rows that changed.
+static void Compose(compositor_t *slot, const uint8_t cells[4][2], uint16_t color)
+{
+    uint16_t y, h;
+
+    Compositor_Clear(slot);
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        Compositor_Rect(slot, slot->x + cells[i][0] * 10, slot->y + cells[i][1] * 10, 8, 8,
+                        color);
+    }
+
+    if (Compositor_Commit(slot, &y, &h))
+        Compositor_Draw(slot, y, h);
+}
+
+// OldBoard
+// Draws the board the way the game did before the pattern fill: the frame
+// outline, optionally a clear of the cells like after a loss, and a rect
+// per grid line.
+static void OldBoard(bool clear)
+{
+    ST7789_DrawOutline(GRID_X, GRID_Y, GRID_W, GRID_H, ST7789_WHITE);
+    if (clear)
+    {
+        ST7789_DrawRectangle(FRAME_X_OFF, FRAME_Y_OFF, BLOCK_SIZE * COLS - 1,
+                             BLOCK_SIZE * ROWS - 1, ST7789_BLACK);
+    }
+
+    for (uint8_t i = 1; i < COLS; i++)
+    {
+        ST7789_DrawRectangle(FRAME_X_OFF + BLOCK_SIZE * i - 1, FRAME_Y_OFF, 2,
+                             BLOCK_SIZE * ROWS, DARK_GRAY);
+    }
+    for (uint8_t i = 1; i < ROWS; i++)
+    {
+        ST7789_DrawRectangle(FRAME_X_OFF, FRAME_Y_OFF + BLOCK_SIZE * i - 1, BLOCK_SIZE * COLS,
+                             2, DARK_GRAY);
+    }
+
+#ifdef BOARD_SCROLL_LAYOUT
+    ST7789_DrawRectangle(FRAME_X_OFF, FRAME_Y_OFF, BLOCK_SIZE * COLS, 1, DARK_GRAY);
+    ST7789_DrawRectangle(FRAME_X_OFF, FRAME_Y_OFF + BLOCK_SIZE * ROWS - 1, BLOCK_SIZE * COLS, 1,
+                         DARK_GRAY);
+#endif
+}
+
+// Grid
+// Draws the game board the old way, clearing it like after a loss, then
+// as the game's pattern fill over garbage, and checks both leave the same
+// pixels.
+// Return: int, 1 if they differ
+static int Grid(void)
+{
+    static uint16_t drawn[GRID_H][GRID_W];
+    emuCounters_t c;
+    int differs = 0;
+
+    // the old clear left the last column to the screen clear at startup
+    ST7789_DrawRectangle(GRID_X, GRID_Y, GRID_W, GRID_H, ST7789_BLACK);
+    Emu_TakeCounters(&c);
+
+    OldBoard(true);
+    Emu_TakeCounters(&c);
+    PrintCounters("grid rects", &c);
+
+    for (uint16_t y = 0; y < GRID_H; y++)
+    {
+        for (uint16_t x = 0; x < GRID_W; x++)
+            drawn[y][x] = Emu_GetPixel(GRID_X + x, GRID_Y + y);
+    }
+
+    // garbage, then a window elsewhere so the fill sends all of its own
+    ST7789_DrawRectangle(GRID_X, GRID_Y, GRID_W, GRID_H, ST7789_RED);
+    ST7789_DrawPixel(0, 0, ST7789_BLACK);
+    Emu_TakeCounters(&c);
+
+    ST7789_FillPattern(GRID_X, GRID_Y, GRID_W, GRID_H, BoardGrid_Pattern());
+    Emu_TakeCounters(&c);
+    PrintCounters("grid pattern", &c);
+
+    for (uint16_t y = 0; y < GRID_H; y++)
+    {
+        for (uint16_t x = 0; x < GRID_W; x++)
+            differs |= drawn[y][x] != Emu_GetPixel(GRID_X + x, GRID_Y + y);
+    }
+    if (differs)
+        printf("grid pattern draws a different board\n");
+
+    return differs;
+}
+
+// Startup
+// Resets the panel and runs what the game does up to its first list: init,
+// the clock probe and the board, drawn the old way or as the pattern fill,
+// as one batch. The rest of the first list is the same either way. Prints
+// the total, delays included.
+static void Startup(const char *name, bool pattern)
+{
+    emuCounters_t c, total = { 0 }, max = { 0 };
+
+    Emu_Reset();
+    ST7789_Init();
+    ST7789_ProbeClock();
+    Emu_TakeCounters(&c);
+    Accumulate(&total, &max, &c);
+
+    ST7789_BeginBatch();
+    if (pattern)
+        ST7789_FillPattern(GRID_X, GRID_Y, GRID_W, GRID_H, BoardGrid_Pattern());
+    else
+        OldBoard(false);
+    ST7789_EndBatch();
+    Emu_TakeCounters(&c);
+    Accumulate(&total, &max, &c);
+
+    PrintCounters(name, &total);
+    printf("%-16s %u us from reset to the first list\n", name,
+           Emu_WireTimeUs(&total) + total.delayUs);
+}
+
+// Transfer
+// Sends n items through the uDMA straight from SPI_WriteDMA (bytes) or
+// SPI_WriteRepeatDMA (one pixel n times, from 8-bit frames) into the top
+// rows of the screen, and checks the pixels that landed, the frame size
+// after and how often the channel was started.
+// Return: int, 1 if anything came out wrong
+static int Transfer(const uint8_t *bytes, uint32_t n, bool repeat, uint32_t starts)
+{
+    const uint16_t value = 0xA5C3;
+    uint32_t pixels = repeat ? n : (n + 1) / 2;
+    uint16_t rows = (pixels + X_MAX - 1) / X_MAX;
+    uint32_t wrong = 0;
+    uint8_t command = ST7789_RAMWR_ADDR;
+    uint32_t clock = SPI_GetClock(SPI_A_BASE);
+    emuCounters_t c;
+
+    // leaves the window set, DC high and SCK at the write clock
+    ST7789_DrawRectangle(0, 0, X_MAX, rows, ST7789_BLACK);
+    Emu_TakeCounters(&c);
+
+    GPIOPinWrite(ST7789_PIN_PORT_BASE, ST7789_CS_PIN | ST7789_DC_PIN, 0x00);
+    SPI_SetClock(SPI_A_BASE, ST7789_COMMAND_CLOCK_HZ);
+    SPI_WriteStream(SPI_A_BASE, &command, 1);
+    SPI_SetClock(SPI_A_BASE, clock);
+    GPIOPinWrite(ST7789_PIN_PORT_BASE, ST7789_DC_PIN, 0xFF);
+    if (repeat)
+    {
+        SPI_WriteRepeatDMA(SPI_A_BASE, value, n);
+    }
+    else
+    {
+        SPI_WriteDMA(SPI_A_BASE, bytes, n);
+        // second byte of the last pixel
+        if (n & 1)
+            SPI_WriteStream(SPI_A_BASE, &bytes[n], 1);
+    }
+    GPIOPinWrite(ST7789_PIN_PORT_BASE, ST7789_CS_PIN, 0xFF);
+    Emu_TakeCounters(&c);
+
+    for (uint32_t i = 0; i < pixels; i++)
+    {
+        uint16_t color = repeat ? value : bytes[2 * i] << 8 | bytes[2 * i + 1];
+
+        wrong += Emu_GetPixel(i % X_MAX, i / X_MAX) != color;
+    }
+
+    if (!wrong && !c.errors && c.pixels == pixels && c.dmaStarts == starts
+            && SPI_GetFrameSize(SPI_A_BASE) == 8)
+        return 0;
+
+    printf("%s of %u: %u wrong pixels, %u pixels, %u starts (not %u), %u bit frames after,"
+           " %u errors\n", repeat ? "repeat" : "buffer", n, wrong, c.pixels, c.dmaStarts, starts,
+           SPI_GetFrameSize(SPI_A_BASE), c.errors);
+    return 1;
+}
+
+// Transfers
+// Runs the ping-pong refill of multimod_spi.c with the uDMA done interrupt
+// coming after every chunk, only after both halves ran dry, and not at all
+// (polled), for transfers shorter than one chunk, of exactly two chunks,
+// and of three chunks and an odd remainder.
+// Return: int, number of transfers that came out wrong
+static int Transfers(void)
+{
+    static const char *const names[] = { "prompt", "late", "polled" };
+    static const uint32_t lengths[] = { 1, 2 * SPI_DMA_MAX_ITEMS, 3 * SPI_DMA_MAX_ITEMS + 7 };
+    static uint8_t bytes[3 * SPI_DMA_MAX_ITEMS + 8];
+    int errors = 0;
+
+    for (uint32_t i = 0; i < sizeof(bytes); i++)
+        bytes[i] = i * 7 + (i >> 8);
+
+    for (int when = EMU_DMA_PROMPT; when <= EMU_DMA_POLLED; when++)
+    {
+        int bad = 0;
+
+        Emu_SetDMAInterrupt((emuDMAInterrupt_t) when);
+
+        for (uint8_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+        {
+            uint32_t chunks = (lengths[i] + SPI_DMA_MAX_ITEMS - 1) / SPI_DMA_MAX_ITEMS;
+
+            // two chunks are armed per start, a late handler restarts the
+            // channel once both ran dry
+            uint32_t starts = when == EMU_DMA_PROMPT ? 1 : (chunks + 1) / 2;
+
+            bad += Transfer(bytes, lengths[i], false, starts);
+            bad += Transfer(bytes, lengths[i], true, starts);
+        }
+
+        printf("dma %-12s %u transfers, %u wrong\n", names[when],
+               (unsigned) (2 * sizeof(lengths) / sizeof(lengths[0])), bad);
+        errors += bad;
+    }
+
+    Emu_SetDMAInterrupt(EMU_DMA_PROMPT);
+    return errors;
+}
+
+// Area
+// Checks that a rectangle of the screen is all one color.
+// Return: int, 1 if any pixel differs
+static int Area(const char *name, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                uint16_t color)
+{
+    for (uint16_t j = y; j < y + h; j++)
+    {
+        for (uint16_t i = x; i < x + w; i++)
+        {
+            if (Emu_GetPixel(i, j) != color)
+            {
+                printf("%s: pixel %u, %u is %04X, not %04X\n", name, i, j, Emu_GetPixel(i, j),
+                       color);
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+// OddAreas
+// Draws areas of an odd number of pixels in RGB444 mode, which end half
+// way through a byte, and checks their last pixel landed. In a batch CS
+// stays low, so the draw after one has to land too.
+// Return: int, number of draws that came out wrong
+static int OddAreas(void)
+{
+    uint16_t white = ST7789_FromRGB444(ST7789_ToRGB444(ST7789_WHITE));
+    uint16_t red = ST7789_FromRGB444(ST7789_ToRGB444(ST7789_RED));
+    emuCounters_t c;
+    int errors = 0;
+
+    ST7789_DrawRectangle(0, 0, 40, 20, ST7789_BLACK);
+    Emu_TakeCounters(&c);
+
+    ST7789_DrawPixel(2, 2, ST7789_WHITE);
+    Emu_TakeCounters(&c);
+    PrintCounters("pixel 444", &c);
+    errors += Area("pixel 444", 2, 2, 1, 1, white) || c.errors;
+
+    ST7789_DrawLine(6, 2, 6, 8, ST7789_WHITE);
+    Emu_TakeCounters(&c);
+    PrintCounters("span 1x7 444", &c);
+    errors += Area("span 1x7 444", 6, 2, 1, 7, white) || c.errors;
+
+    ST7789_DrawRectangle(10, 10, 3, 3, ST7789_WHITE);
+    Emu_TakeCounters(&c);
+    PrintCounters("rect 3x3 444", &c);
+    errors += Area("rect 3x3 444", 10, 10, 3, 3, white) || c.errors;
+
+    ST7789_BeginBatch();
+    ST7789_DrawRectangle(20, 10, 3, 3, ST7789_WHITE);
+    ST7789_DrawRectangle(26, 10, 4, 4, ST7789_RED);
+    ST7789_EndBatch();
+    Emu_TakeCounters(&c);
+    PrintCounters("batch 3x3 4x4 444", &c);
+    errors += (Area("batch 3x3 4x4 444", 20, 10, 3, 3, white)
+            || Area("batch 3x3 4x4 444", 26, 10, 4, 4, red) || c.errors);
+
+    return errors;
+}
+
+// Scene
+// Draws one of everything and prints what each call cost.
+// Return: int, number of draws that came out wrong
+static int Scene(void)
+{
+    static const uint8_t tPiece[4][2] = { { 0, 1 }, { 1, 1 }, { 2, 1 }, { 1, 2 } };
+    static const uint8_t sPiece[4][2] = { { 0, 1 }, { 1, 1 }, { 1, 2 }, { 2, 2 } };
+    static compositor_t slot;
+    emuCounters_t c;
+    int errors = 0;
+
+    ST7789_Fill(ST7789_BLACK);
+    Emu_TakeCounters(&c);
+    PrintCounters("fill", &c);
+
+    ST7789_DrawRectangle(50, 50, 10, 10, ST7789_RED);
+    Emu_TakeCounters(&c);
+    PrintCounters("rect 10x10", &c);
+
+    ST7789_DrawOutline(70, 50, 8, 8, ST7789_WHITE);
+    Emu_TakeCounters(&c);
+    PrintCounters("outline 8x8", &c);
+
+    ST7789_DrawLine(10, 20, 229, 90, ST7789_GREEN);
+    Emu_TakeCounters(&c);
+    PrintCounters("line", &c);
+
+    ST7789_DrawText(&FontStyle_Emulogic, "SCORE 1200", 60, 300, ST7789_WHITE, ST7789_BLACK);
+    Emu_TakeCounters(&c);
+    PrintCounters("text 10 chars", &c);
+
+    ST7789_DrawSprite(&Sprite_Block, 100, 120);
+    Emu_TakeCounters(&c);
+    PrintCounters("sprite block", &c);
+
+    ST7789_DrawSprite(&Sprite_Logo, 72, 150);
+    Emu_TakeCounters(&c);
+    PrintCounters("sprite logo", &c);
+
+    Compositor_Init(&slot, 161, 244, 38, 40, ST7789_BLACK);
+    Compose(&slot, tPiece, ST7789_MAGENTA);
+    Emu_TakeCounters(&c);
+    PrintCounters("preview slot", &c);
+
+    Compose(&slot, sPiece, ST7789_GREEN);
+    Emu_TakeCounters(&c);
+    PrintCounters("preview changed", &c);
+
+    Compose(&slot, sPiece, ST7789_GREEN);
+    Emu_TakeCounters(&c);
+    PrintCounters("preview same", &c);
+
+    errors += Grid();
+    errors += Transfers();
+
+    ST7789_SetPartialArea(82, 202);
+    ST7789_SetMode(ST7789_MODE_PARTIAL_IDLE);
+    Emu_TakeCounters(&c);
+    PrintCounters("partial idle", &c);
+
+    ST7789_SetMode(ST7789_MODE_SLEEP);
+    ST7789_SetMode(ST7789_MODE_NORMAL);
+    Emu_TakeCounters(&c);
+    PrintCounters("sleep and wake", &c);
+
+    ST7789_SetColorMode(ST7789_COLMOD_RGB444);
+    Emu_TakeCounters(&c);
+
+    ST7789_DrawRectangle(50, 50, 10, 10, ST7789_RED);
+    Emu_TakeCounters(&c);
+    PrintCounters("rect 10x10 444", &c);
+
+    ST7789_DrawText(&FontStyle_Emulogic, "SCORE 1200", 60, 300, ST7789_WHITE, ST7789_BLACK);
+    Emu_TakeCounters(&c);
+    PrintCounters("text 444", &c);
+
+    ST7789_DrawSprite(&Sprite_Logo, 72, 180);
+    Emu_TakeCounters(&c);
+    PrintCounters("sprite logo 444", &c);
+
+    errors += OddAreas();
+
+    ST7789_SetColorMode(ST7789_COLMOD_RGB565);
+
+    return errors;
+}
+
+/********************************Private Functions**********************************/
+
+/************************************MAIN*******************************************/
+
+int main(int argc, char **argv)
+{
+    const char *trace = NULL, *out = NULL, *snapshots = NULL;
+    int verbose = 0, batch = 1, rgb444 = 0, match = 0, errors = 0;
+    uint32_t clock;
+    emuCounters_t c;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-v"))
+            verbose = 1;
+        else if (!strcmp(argv[i], "-u"))
+            batch = 0;
+        else if (!strcmp(argv[i], "-4"))
+            rgb444 = 1;
+        else if (!strcmp(argv[i], "-m"))
+            match = 1;
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc)
+            snapshots = argv[++i];
+        else if (!strcmp(argv[i], "-o") && i + 1 < argc)
+            out = argv[++i];
+        else if (!strcmp(argv[i], "-c") && i + 1 < argc)
+            Emu_SetMaxWriteClock(strtoul(argv[++i], NULL, 0));
+        else if (!trace && argv[i][0] != '-')
+            trace = argv[i];
+        else
+        {
+            fprintf(stderr,
+                    "usage: %s [-v] [-u] [-4] [-m] [-c max_write_hz] [-s snapshot_prefix]"
+                    " [-o out.ppm] [trace.txt]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    Emu_Reset();
+    ST7789_Init();
+    Emu_TakeCounters(&c);
+    PrintCounters("init", &c);
+    errors += c.errors != 0;
+
+    clock = ST7789_ProbeClock();
+    Emu_TakeCounters(&c);
+    PrintCounters("clock probe", &c);
+    printf("write clock %u Hz\n", clock);
+    errors += c.errors != 0;
+
+    if (trace)
+    {
+        int bad;
+
+        if (rgb444)
+            ST7789_SetColorMode(ST7789_COLMOD_RGB444);
+        bad = ReplayTrace(trace, snapshots, verbose, batch, 0);
+        if (bad < 0)
+            return 2;
+        errors += bad;
+
+        if (match)
+        {
+            Emu_Reset();
+            ST7789_Init();
+            ST7789_ProbeClock();
+            if (rgb444)
+                ST7789_SetColorMode(ST7789_COLMOD_RGB444);
+            Emu_TakeCounters(&c);
+            bad = ReplayTrace(trace, NULL, verbose, !batch, 1);
+            printf("%s replay: %d frames wrong\n", batch ? "unbatched" : "batched", bad);
+            errors += bad;
+        }
+    }
+    else
+    {
+        errors += Scene();
+        Startup("startup rects", false);
+        Startup("startup pattern", true);
+    }
+
+    if (out && !Emu_WritePPM(out))
+    {
+        perror(out);
+        return 2;
+    }
+
+    return errors ? 1 : 0;
+}
+
+/************************************MAIN*******************************************/